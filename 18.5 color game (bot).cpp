@@ -0,0 +1,117 @@
+/*
+Color Game bot harness
+Plays headless games as fast as possible on every core and reports
+throughput and the difficulty curve of the CIEDE2000 difficulty table, or of
+the DIFFICULTY/MAX_LEVEL rule it replaced when run with "rule".
+
+Usage: bot [games] [threads] [noise] [seed] [normal|protan|deutan|tritan] [grid, e.g. 64x64] [table|rule]
+The same seed gives the same results on any number of threads.
+*/
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <mutex>
+#include "ColorGameEngine.h"
+#include "ColorGameBot.h"
+#include "WorkStealingPool.h"
+#include "GameRng.h"
+#include "DifficultyTable.h"
+#include "ColorVision.h"
+#include "BoardLayout.h"
+
+//Games played by one pool task
+const int GAMES_PER_TASK = 1000;
+
+int main(int argc, char* args[])
+{
+	//Read options
+	long long totalGames = argc > 1 ? atoll(args[1]) : 100000;
+	int threads = argc > 2 ? atoi(args[2]) : 0;
+	float noise = argc > 3 ? (float)atof(args[3]) : 0.0f;
+	Uint64 seed = argc > 4 ? strtoull(args[4], NULL, 10) : (Uint64)time(NULL);
+	ColorDeficiency vision = argc > 5 ? parseColorDeficiency(args[5]) : VISION_NORMAL;
+	int columns = 3;
+	int rows = 3;
+	if (argc > 6 && !BoardLayout::parseGrid(args[6], &columns, &rows))
+	{
+		printf("Invalid grid %s\n", args[6]);
+		return 1;
+	}
+	bool useTable = true;
+	if (argc > 7)
+	{
+		if (strcmp(args[7], "rule") == 0)
+		{
+			useTable = false;
+		}
+		else if (strcmp(args[7], "table") != 0)
+		{
+			printf("Invalid difficulty %s\n", args[7]);
+			return 1;
+		}
+	}
+
+	//Shared by every task, read-only once built, engines fall back to the DIFFICULTY rule without it
+	DifficultyTable difficulty;
+	const DifficultyTable* table = NULL;
+	if (useTable)
+	{
+		difficulty.build(MAX_LEVEL + 1);
+		table = &difficulty;
+	}
+
+	WorkStealingPool pool(threads);
+	BotStats total;
+	std::mutex totalMutex;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	//Each task plays a batch with its own engine and bot, seeded from the run seed
+	Uint64 seedState = seed;
+	for (long long queued = 0; queued < totalGames; queued += GAMES_PER_TASK)
+	{
+		long long batch = totalGames - queued < GAMES_PER_TASK ? totalGames - queued : GAMES_PER_TASK;
+		Uint64 engineSeed = GameRng::splitMix(seedState);
+		Uint64 botSeed = GameRng::splitMix(seedState);
+		pool.submit([batch, engineSeed, botSeed, noise, vision, columns, rows, table, &total, &totalMutex]()
+		{
+			ColorGameEngine engine(columns * rows, engineSeed);
+			engine.setDifficultyTable(table);
+			ColorGameBot bot(botSeed, noise);
+			bot.setDeficiency(vision);
+			BotStats stats;
+			for (long long i = 0; i < batch; i++)
+			{
+				bot.playGame(engine, stats);
+			}
+
+			std::lock_guard<std::mutex> lock(totalMutex);
+			total.merge(stats);
+		});
+	}
+	pool.wait();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	//Throughput
+	printf("Threads: %d  Noise: %.2f  Seed: %llu  Vision: %d  Grid: %dx%d  Difficulty: %s\n", pool.getThreadCount(), noise, (unsigned long long)seed, (int)vision, columns, rows,
+		useTable ? "table" : "rule");
+	printf("Games: %lld  Rounds: %lld  Wins: %lld\n", total.games, total.rounds, total.wins);
+	printf("Time: %.3f s  Rounds/sec: %.0f  Games/sec: %.0f\n",
+		seconds, seconds > 0.0 ? total.rounds / seconds : 0.0, seconds > 0.0 ? total.games / seconds : 0.0);
+
+	//Difficulty curve
+	printf("\nLevel  Decrease  DeltaE  Attempts  Clear rate\n");
+	for (int level = 0; level <= MAX_LEVEL; level++)
+	{
+		if (total.levelAttempts[level] == 0)
+			continue;
+		printf("%5d  %8d  %6.2f  %8lld  %9.2f%%\n", level, total.levelDecrease[level], total.levelDeltaE[level], total.levelAttempts[level],
+			100.0 * total.levelClears[level] / total.levelAttempts[level]);
+	}
+
+	return 0;
+}
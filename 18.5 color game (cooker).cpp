@@ -0,0 +1,82 @@
+/*
+Color Game texture cooker
+Converts images to the renderer's native pixel format so the game can upload them without decoding.
+Each image.png gets an image.cgtx next to it, which the game and the packer pick up.
+
+Usage: cooker img/colorgame_intro_screen.png img/colorgame_game_over.png
+*/
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string>
+#include "CookedTexture.h"
+
+//Gets the pixel format the game's renderer would store textures in
+Uint32 nativeTextureFormat()
+{
+	Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+	SDL_Window* window = SDL_CreateWindow("Color Game cooker", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1, 1, SDL_WINDOW_HIDDEN);
+	if (window == NULL)
+	{
+		return format;
+	}
+	SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	SDL_RendererInfo info;
+	if (renderer != NULL && SDL_GetRendererInfo(renderer, &info) == 0 && info.num_texture_formats > 0)
+	{
+		//First format is the renderer's preferred one
+		format = info.texture_formats[0];
+	}
+	if (renderer != NULL)
+	{
+		SDL_DestroyRenderer(renderer);
+	}
+	SDL_DestroyWindow(window);
+	return format;
+}
+
+int main(int argc, char* args[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s <image> [image...]\n", args[0]);
+		return 1;
+	}
+
+	if (SDL_Init(SDL_INIT_VIDEO) < 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG))
+	{
+		printf("Failed to initialize! SDL Error: %s\n", SDL_GetError());
+		return 1;
+	}
+
+	Uint32 format = nativeTextureFormat();
+	printf("Cooking to %s\n", SDL_GetPixelFormatName(format));
+
+	int failed = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		SDL_Surface* surface = IMG_Load(args[i]);
+		std::string cookedPath = cookedTexturePath(args[i]);
+		if (surface == NULL)
+		{
+			printf("Unable to load image %s SDL_image Error: %s\n", args[i], IMG_GetError());
+			failed++;
+		}
+		else
+		{
+			if (cookTexture(surface, format, cookedPath))
+			{
+				printf("%s -> %s\n", args[i], cookedPath.c_str());
+			}
+			else
+			{
+				failed++;
+			}
+			SDL_FreeSurface(surface);
+		}
+	}
+
+	IMG_Quit();
+	SDL_Quit();
+	return failed == 0 ? 0 : 1;
+}
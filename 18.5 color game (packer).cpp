@@ -0,0 +1,42 @@
+/*
+Color Game asset packer
+Packs loose asset files into one archive the game memory-maps at startup.
+
+Usage: packer colorgame.pak WeLoveCuteThings.ttf img/colorgame_intro_screen.png img/colorgame_game_over.png
+*/
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "AssetArchive.h"
+
+int main(int argc, char* args[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s <archive> <file> [file...]\n", args[0]);
+		return 1;
+	}
+
+	std::vector<std::string> files;
+	for (int i = 2; i < argc; i++)
+	{
+		files.push_back(args[i]);
+	}
+
+	if (!AssetArchive::pack(args[1], files))
+	{
+		printf("Failed to pack %s\n", args[1]);
+		return 1;
+	}
+
+	//Read it back to make sure the game can use it
+	AssetArchive archive;
+	if (!archive.open(args[1]))
+	{
+		printf("Failed to verify %s\n", args[1]);
+		return 1;
+	}
+	printf("Packed %d files into %s\n", (int)files.size(), args[1]);
+	return 0;
+}
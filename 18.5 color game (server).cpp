@@ -0,0 +1,127 @@
+/*
+Color Game session server load test
+Hosts many games in one process and drives each one with a simulated player
+over a local socket, then reports how many sessions and rounds per second it kept up with.
+
+Usage: server [sessions] [seconds] [threads] [seed] [grid, e.g. 8x8]
+*/
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <vector>
+#include "GameSession.h"
+#include "SessionServer.h"
+#include "LocalSocket.h"
+#include "GameRng.h"
+#include "DifficultyTable.h"
+#include "BoardLayout.h"
+
+//Simulated time between server ticks, one 60 fps frame
+const Uint64 SERVER_TICK_MICROS = 1000000 / 60;
+
+//Chance a simulated player misses the odd cell at the hardest level
+const float PLAYER_MAX_MISS = 0.5f;
+
+//Simulated player on the other end of a socket
+struct Player
+{
+	LocalSocket* socket;
+	GameRng rng;
+	long long games;
+};
+
+//Answers the latest board the way a person would
+void playBoard(Player& player, const BoardMessage& board)
+{
+	ClickMessage click;
+	click.session = board.session;
+	click.cell = 0;
+	if (board.state == IN_GAME)
+	{
+		//Harder levels get missed more often
+		float miss = PLAYER_MAX_MISS * board.level / MAX_LEVEL;
+		int cells = board.columns * board.rows;
+		click.cell = player.rng.nextFloat() < miss ? (int)((board.oddCell + 1 + player.rng.nextBelow(cells - 1)) % cells) : (int)board.oddCell;
+	}
+	else if (board.state == GAME_OVER || board.state == VICTORY_SCREEN)
+	{
+		player.games++;
+	}
+	player.socket->send(&click, sizeof(click));
+}
+
+int main(int argc, char* args[])
+{
+	//Read options
+	int sessions = argc > 1 ? atoi(args[1]) : 500;
+	double runSeconds = argc > 2 ? atof(args[2]) : 5.0;
+	int threads = argc > 3 ? atoi(args[3]) : 0;
+	Uint64 seed = argc > 4 ? strtoull(args[4], NULL, 10) : (Uint64)time(NULL);
+	int columns = 3;
+	int rows = 3;
+	if (argc > 5 && !BoardLayout::parseGrid(args[5], &columns, &rows))
+	{
+		printf("Invalid grid %s\n", args[5]);
+		return 1;
+	}
+
+	//Shared by every session, read-only once built
+	DifficultyTable difficulty;
+	difficulty.build(MAX_LEVEL + 1);
+
+	SessionServer server(threads, &difficulty);
+	std::vector<Player> players(sessions);
+	Uint64 seedState = seed;
+	for (int i = 0; i < sessions; i++)
+	{
+		players[i].socket = server.connect(columns, rows, GameRng::splitMix(seedState));
+		players[i].rng.seed(GameRng::splitMix(seedState));
+		players[i].games = 0;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	double seconds = 0.0;
+	Uint64 micros = 0;
+	long long tickCount = 0;
+	while (seconds < runSeconds)
+	{
+		server.tick(micros);
+		micros += SERVER_TICK_MICROS;
+		tickCount++;
+
+		//Every player answers the newest board it got this tick
+		BoardMessage board;
+		for (int i = 0; i < sessions; i++)
+		{
+			bool received = false;
+			BoardMessage latest;
+			while (players[i].socket->receive(&board, sizeof(board)) == sizeof(board))
+			{
+				latest = board;
+				received = true;
+			}
+			if (received)
+			{
+				playBoard(players[i], latest);
+			}
+		}
+
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	long long games = 0;
+	for (int i = 0; i < sessions; i++)
+	{
+		games += players[i].games;
+	}
+
+	printf("Sessions: %d  Threads: %d  Shards: %d  Seed: %llu  Grid: %dx%d\n", server.getSessionCount(),
+		server.getThreadCount(), server.getShardCount(), (unsigned long long)seed, columns, rows);
+	printf("Ticks: %lld  Rounds: %lld  Games: %lld  Messages: %lld\n", tickCount, server.getRoundsServed(), games, server.getMessagesSent());
+	printf("Time: %.3f s  Ticks/sec: %.0f  Rounds/sec: %.0f  Session rounds/sec: %.1f\n", seconds,
+		tickCount / seconds, server.getRoundsServed() / seconds, server.getRoundsServed() / seconds / sessions);
+
+	return 0;
+}
@@ -6,12 +6,37 @@ Date: 5/29/15
 #include <SDL.h>
 #include <SDL_image.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <string>
 #include <iostream>
-#include <sstream>
 #include <cmath>
 #include "LTexture.h"
+#include "GlyphAtlas.h"
+#include "HudLabel.h"
+#include "FrameScheduler.h"
+#include "RetainedScene.h"
+#include "GridRenderer.h"
+#include "GridHitTest.h"
+#include "BoardLayout.h"
+#include "ColorGameEngine.h"
+#include "GameSession.h"
+#include "SdlRenderer.h"
+#include "FrameProfiler.h"
+#include "AssetCache.h"
+#include "AsyncAssetLoader.h"
+#include "AssetArchive.h"
+#include "CookedTexture.h"
+#include "InputLog.h"
+#include "DifficultyTable.h"
+#include "ColorVision.h"
+#include "NullRenderer.h"
+#include "FrameCapture.h"
+#include "RenderQueue.h"
+#include "LatencyTracker.h"
 #include <time.h> 
+#include <thread>
+#include <atomic>
 #include <SDL_ttf.h>
 
 using namespace std;
@@ -19,139 +44,177 @@ using namespace std;
 //Starting Screen dimension constants
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
-const int TOTAL_BUTTONS = 9;
-const int BUTTON_WIDTH = SCREEN_WIDTH / 3;
-const int BUTTON_HEIGHT = SCREEN_HEIGHT / 3;
-const int DIFFICULTY = 32; //1 = hardest 
-const int MAX_LEVEL = 30;
-
-const int INTRO_SCREEN = 0;
-const int IN_GAME  = 1;
-const int GAME_OVER = 2;
-const int QUIT_GAME = 3;
-const int VICTORY_SCREEN = 4;
-
-enum LButtonSprite
-{
-	BUTTON_SPRITE_MOUSE_OUT = 0,  
-	BUTTON_SPRITE_MOUSE_OVER_MOTION = 1,
-	BUTTON_SPRITE_MOUSE_DOWN = 2,
-	BUTTON_SPRITE_MOUSE_UP = 3,
-	BUTTON_SPRITE_TOTAL = 4
-};
+const int HUD_HEIGHT = 30;
+//Default board, --grid sets any size up to MAX_GRID_SIZE
+const int GRID_COLUMNS = 3;
+const int GRID_ROWS = 3;
+//Frame pacing, static screens are always event driven
+//Presents happen on the render thread, so FRAME_VSYNC would leave the logic thread unpaced
+const FrameMode IN_GAME_FRAME_MODE = FRAME_FIXED_FPS;
+const int TARGET_FPS = 60;
+//Longest the render thread sleeps without a new frame, it still uploads finished assets
+const Uint32 RENDER_IDLE_WAIT = 50;
+
+//Asset paths
+const char* FONT_PATH = "18.5 color game/WeLoveCuteThings.ttf";
+const char* INTRO_SCREEN_PATH = "img/colorgame_intro_screen.png";
+const char* GAME_OVER_PATH = "img/colorgame_game_over.png";
+const char* PLAY_AGAIN_TEXT = "Click anywhere to play again!";
+
+//Packed assets next to the executable, loose files are used when missing
+const char* ASSET_ARCHIVE_NAME = "colorgame.pak";
+
+//GPU memory the asset cache may keep
+const size_t ASSET_BUDGET_BYTES = 32 * 1024 * 1024;
+
+
+//Starts up SDL, creates window and starts rendering
+bool init();
 
+//Queues media loading, it finishes in the background
+bool loadMedia();
 
+//Frees media and shuts down SDL
+void close();
 
-//The mouse button
-class LButton
-{
-public:
-	//Initializes internal variables
-	LButton();
+//Loads an image from the archive, or from disk if it is not packed
+//Cooked pixels are preferred over the PNG in both places
+SDL_Surface* loadImageSurface(const char* path);
 
-	//Sets top left position
-	void setPosition(int x, int y);
+//Loads a screen image as the simulated color vision sees it
+SDL_Surface* loadScreenSurface(const char* path);
 
-	//Handles mouse event
-	bool handleEvent(SDL_Event* e);
+//Opens a font from the archive, or from disk if it is not packed
+TTF_Font* openFont(const char* path, int size);
 
-	//Shows button sprite
-	void render();
+//Recomputes the hit test layout on resize, returns true if it changed
+bool handleLayoutEvent(SDL_Event* e);
 
-private:
-	//Top left position
-	SDL_Point mPosition;
+//Takes a new pixel scale from the render thread and recomputes the hit test layout with it
+void updateLayoutScale();
 
-	//Currently used global sprite
-	LButtonSprite mCurrentSprite;
-};
+//Creates gRenderer and everything drawn with it, on the thread that will render
+bool createRenderer();
 
-//Starts up SDL and creates window
-bool init();
+//Frees everything drawn with gRenderer and destroys it, on the thread that created it
+void destroyRenderer();
 
-//load media
-bool loadMedia();
+//Stops the render thread, which destroys the renderer on its way out, safe to call more than once
+void stopRendering();
 
-//Frees media and shuts down SDL
-void close();
+//Takes the newest frame from the logic thread and draws it, waiting up to timeout for one
+//Runs on the render thread, or inline on the main thread when capturing
+void renderPass(Uint32 timeout);
+
+//Render thread body, creates the renderer, reports whether it could and draws until gRenderStop is set
+void renderLoop(SDL_sem* ready, bool* created);
 
 //The window we'll be rendering to
 SDL_Window* gWindow = NULL;
 
-//The window renderer
+//The window renderer, only used by the thread that created it
 SDL_Renderer* gRenderer = NULL;
 
+//Shared textures, each loaded once
+AssetCache gAssets(ASSET_BUDGET_BYTES);
+
+//Memory-mapped asset archive, must outlive fonts opened from it
+AssetArchive gArchive;
+
+//Decodes media in the background
+AsyncAssetLoader gLoader;
+
+//Set if any media failed to load, written by the render thread
+std::atomic<bool> gMediaFailed(false);
+
 //Scene textures
-LTexture gIntroTexture;
-LTexture gGameOverTexture;
-LTexture gTextTexture;
+TextureHandle gIntroTexture;
+TextureHandle gGameOverTexture;
+TextureHandle gPlayAgainTexture;
+
+//HUD glyph atlas
+GlyphAtlas gHudAtlas;
+
+//Text labels, each with its own texture slot
+HudLabel gTimeLabel("Time: ");
+HudLabel gScoreLabel("Score: ");
+HudLabel gFinalScoreLabel("Your final score: ");
+HudLabel gWinTimeLabel("You won in: ", " seconds!");
 
-//Buttons objects
-LButton gButtons[TOTAL_BUTTONS];
+//Board and HUD placement, hit testing reads this copy on the logic thread
+//Recomputed there from the window size, only the pixel scale comes from the render thread
+BoardLayout gLayout;
+
+//Render thread's copy of the layout, recomputed there from the renderer on resize
+BoardLayout gRenderLayout;
+
+//Maps clicks to board cells
+GridHitTest gHitTest;
 
 //Globally used font
 TTF_Font *gFont = NULL;
 
+//Small font for the profiler overlay
+TTF_Font *gOverlayFont = NULL;
 
-LButton::LButton()
-{
-	mPosition.x = 0;
-	mPosition.y = 0;
+//Frame section timings
+FrameProfiler gProfiler;
 
-	mCurrentSprite = BUTTON_SPRITE_MOUSE_OUT;
-}
+//Main loop pacing
+FrameScheduler gScheduler;
 
-void LButton::setPosition(int x, int y)
-{
-	mPosition.x = x;
-	mPosition.y = y;
-}
+//Perceptual color pairs for every level
+DifficultyTable gDifficulty;
 
-bool LButton::handleEvent(SDL_Event* e)
-{
-	//If mouse event happened
-	if (e->type == SDL_MOUSEBUTTONUP)
-	{
-		//Get mouse position
-		int x, y;
-		SDL_GetMouseState(&x, &y);
+//Color vision deficiency boards are chosen for, and whether the screen shows what it looks like
+ColorDeficiency gVision = VISION_NORMAL;
+PairPolicy gPairPolicy = PAIRS_VISIBLE;
+bool gSimulateVision = false;
 
-		//Check if mouse is in button
-		bool inside = true;
+//Session recording and replay, game logic takes its time from here
+InputLog gInput;
 
-		//Mouse is left of the button
-		if (x < mPosition.x)
-		{
-			inside = false;
-		}
-		//Mouse is right of the button
-		else if (x > mPosition.x + BUTTON_WIDTH)
-		{
-			inside = false;
-		}
-		//Mouse above the button
-		else if (y < mPosition.y)
-		{
-			inside = false;
-		}
-		//Mouse below the button
-		else if (y > mPosition.y + BUTTON_HEIGHT)
-		{
-			inside = false;
-		}
+//Retained in-game frame
+RetainedScene gScene;
 
-		return inside;
-	}
+//Color board
+GridRenderer gGrid;
+
+//Offscreen target frames are drawn into and checked against golden hashes
+FrameCapture gCapture;
+
+//Frames from the game logic to the render thread
+RenderQueue gRenderQueue;
+
+//Creates, uses and destroys gRenderer, the main thread only handles input and game logic
+std::thread gRenderThread;
+std::atomic<bool> gRenderStop(false);
+
+//Draws in-game frames, lives on the render thread with gRenderer
+IRenderer* gGameRenderer = NULL;
+
+//Off for headless replays, frames are then handed to a NullRenderer
+bool gDrawEnabled = true;
+
+//Click-to-photon timing, written by whichever thread presents
+LatencyTracker gLatency;
+
+//Last frame the render thread took, redrawn when assets finish uploading
+RenderFrame gRenderFrame;
+bool gHasRenderFrame = false;
 
-	else
-		return false;
-}
 
 bool init()
 {
 	//Initialization flag
 	bool success = true;
 
+	//Captured frames never reach a display
+	if (gCapture.isEnabled())
+	{
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	}
+
 	//Initialize SDL
 	if (SDL_Init(SDL_INIT_VIDEO) < 0)
 	{
@@ -172,8 +235,8 @@ bool init()
 			SDL_WINDOWPOS_CENTERED,
 			SDL_WINDOWPOS_CENTERED,
 			SCREEN_WIDTH,
-			SCREEN_HEIGHT + 30,
-			SDL_WINDOW_SHOWN);
+			SCREEN_HEIGHT + HUD_HEIGHT,
+			SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
 		if (gWindow == NULL)
 		{
 			cout << "Window could not be created! SDL Error: " << SDL_GetError();
@@ -181,47 +244,53 @@ bool init()
 		}
 		else
 		{
-			//Create renderer for window
-			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
-			if (gRenderer == NULL)
+			//Initialize PNG loading
+			int imgFlags = IMG_INIT_PNG;
+			if (!(IMG_Init(imgFlags) & imgFlags))
 			{
-				cout << "Renderer could not be created! SDL_Error: " << SDL_GetError();
+				cout << "SDL_image could not initialize! SDL_image Error: " << SDL_GetError();
 				success = false;
 			}
-			else
+			//Initialize SDL_ttf
+			if (TTF_Init() == -1)
 			{
-				//Initialize renderer color
-				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				printf("SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError());
+				success = false;
+			}
+
+			//Board rendering reads the render thread's layout, hit testing the logic thread's
+			gLayout.setHudHeight(HUD_HEIGHT);
+			gRenderLayout = gLayout;
+			gGrid.setLayout(&gRenderLayout);
+			gHitTest.setLayout(&gLayout);
 
-				//Initialize PNG loading
-				int imgFlags = IMG_INIT_PNG;
-				if (!(IMG_Init(imgFlags) & imgFlags))
+			//A present can no longer hold up input, captures stay in step with the logic instead
+			bool created = false;
+			if (gCapture.isEnabled())
+			{
+				created = createRenderer();
+			}
+			else
+			{
+				SDL_sem* ready = SDL_CreateSemaphore(0);
+				if (ready == NULL)
 				{
-					cout << "SDL_image could not initialize! SDL_image Error: " << SDL_GetError();
-					success = false;
+					printf("Render thread could not be started! SDL Error: %s\n", SDL_GetError());
 				}
-				//Initialize SDL_ttf
-				if (TTF_Init() == -1)
+				else
 				{
-					printf("SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError());
-					success = false;
+					gRenderThread = std::thread(renderLoop, ready, &created);
+					SDL_SemWait(ready);
+					SDL_DestroySemaphore(ready);
 				}
-
-				//Initialize gButton
-				gButtons[0].setPosition(0, 0);
-				gButtons[1].setPosition(SCREEN_WIDTH / 3, 0);
-				gButtons[2].setPosition(2 * SCREEN_WIDTH /3 , 0 );
-				gButtons[3].setPosition(0, SCREEN_HEIGHT / 3);
-				gButtons[4].setPosition(SCREEN_WIDTH / 3, SCREEN_HEIGHT / 3);
-				gButtons[5].setPosition(2 * SCREEN_WIDTH / 3, SCREEN_HEIGHT / 3);
-				gButtons[6].setPosition(0, 2 * SCREEN_HEIGHT / 3);
-				gButtons[7].setPosition(SCREEN_WIDTH / 3, 2 * SCREEN_HEIGHT / 3);
-				gButtons[8].setPosition(2 * SCREEN_WIDTH / 3, 2 * SCREEN_HEIGHT / 3);
-
-
-				//Clear screen
-				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-				SDL_RenderClear(gRenderer);
+			}
+			if (!created)
+			{
+				success = false;
+			}
+			else
+			{
+				updateLayoutScale();
 			}
 		}
 	}
@@ -229,54 +298,549 @@ bool init()
 	return success;
 }
 
-bool loadMedia()
+bool createRenderer()
 {
-	//Loading success flag
-	bool success = true;
+	//Create renderer for window, vsync only if the game is paced by it
+	Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+	if (IN_GAME_FRAME_MODE == FRAME_VSYNC)
+	{
+		rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+	}
+	//Capture draws through the software renderer into its own surface
+	gRenderer = gCapture.isEnabled() ? gCapture.createRenderer(SCREEN_WIDTH, SCREEN_HEIGHT + HUD_HEIGHT) : SDL_CreateRenderer(gWindow, -1, rendererFlags);
+	if (gRenderer == NULL)
+	{
+		cout << "Renderer could not be created! SDL_Error: " << SDL_GetError();
+		return false;
+	}
+
+	//Textures are created on this renderer
+	gAssets.setRenderer(gRenderer);
 
-	//Open the font
-	gFont = TTF_OpenFont("18.5 color game/WeLoveCuteThings.ttf", 36);
-	if (gFont == NULL)
+	//Layout is in renderer pixels, hit testing gets the scale to compute its own
+	gRenderLayout.update(gWindow, gRenderer);
+	gRenderQueue.publishScale(gRenderLayout.getScaleX(), gRenderLayout.getScaleY());
+
+	//In-game frames
+	if (gDrawEnabled)
 	{
-		printf("Failed to load lazy font! SDL_ttf Error: %s\n", TTF_GetError());
-		success = false;
+		SdlRenderer* renderer = new SdlRenderer(gRenderer, &gRenderLayout, &gGrid, &gScene, &gTimeLabel, &gScoreLabel);
+		renderer->setProfiler(&gProfiler);
+		renderer->setDeficiency(gSimulateVision ? gVision : VISION_NORMAL);
+		gGameRenderer = renderer;
+	}
+	else
+	{
+		gGameRenderer = new NullRenderer();
 	}
 
-	//Load texture
-	if (!gGameOverTexture.loadFromFile("img/colorgame_game_over.png", gRenderer))
+	//Clear screen
+	SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+	SDL_RenderClear(gRenderer);
+	return true;
+}
+
+void destroyRenderer()
+{
+	//Free loaded images
+	gGameOverTexture.release();
+	gIntroTexture.release();
+	gPlayAgainTexture.release();
+	gAssets.clear();
+	gFinalScoreLabel.free();
+	gWinTimeLabel.free();
+	gHudAtlas.free();
+	gScene.free();
+	gProfiler.free();
+
+	delete gGameRenderer;
+	gGameRenderer = NULL;
+	if (gRenderer != NULL)
 	{
-		printf("Failed to load front texture!\n");
-		success = false;
+		SDL_DestroyRenderer(gRenderer);
+		gRenderer = NULL;
 	}
+}
 
-	if (!gIntroTexture.loadFromFile("img/colorgame_intro_screen.png", gRenderer))
+SDL_Surface* loadImageSurface(const char* path)
+{
+	//Cooked pixels in the mapping are used in place, no decode or copy
+	std::string cookedPath = cookedTexturePath(path);
+	const void* data;
+	size_t size;
+	if (gArchive.find(cookedPath, &data, &size))
 	{
-		printf("Failed to load front texture!\n");
-		success = false;
+		SDL_Surface* cooked = cookedTextureSurface(data, size);
+		if (cooked != NULL)
+		{
+			return cooked;
+		}
+	}
+	SDL_Surface* cooked = loadCookedTexture(cookedPath);
+	if (cooked != NULL)
+	{
+		return cooked;
 	}
 
-	return success;
+	//Decode straight out of the mapping, no file reads or copies
+	SDL_RWops* rw = gArchive.openRW(path);
+	if (rw != NULL)
+	{
+		return IMG_Load_RW(rw, 1);
+	}
+	return IMG_Load(path);
+}
+
+SDL_Surface* loadScreenSurface(const char* path)
+{
+	SDL_Surface* surface = loadImageSurface(path);
+	if (surface == NULL || !gSimulateVision || gVision == VISION_NORMAL)
+	{
+		return surface;
+	}
+
+	//Screens are converted once here, never per frame
+	SDL_Surface* simulated = simulateDeficiencySurface(surface, gVision);
+	SDL_FreeSurface(surface);
+	return simulated;
+}
+
+TTF_Font* openFont(const char* path, int size)
+{
+	//Font keeps reading from the stream, which stays valid while the archive is mapped
+	SDL_RWops* rw = gArchive.openRW(path);
+	if (rw != NULL)
+	{
+		return TTF_OpenFontRW(rw, 1, size);
+	}
+	return TTF_OpenFont(path, size);
+}
+
+bool loadMedia()
+{
+	//Map packed assets once, falls back to loose files
+	char* basePath = SDL_GetBasePath();
+	std::string archivePath = basePath != NULL ? std::string(basePath) + ASSET_ARCHIVE_NAME : ASSET_ARCHIVE_NAME;
+	SDL_free(basePath);
+	if (!gArchive.open(archivePath))
+	{
+		printf("No asset archive at %s, loading loose files\n", archivePath.c_str());
+	}
+
+	SDL_Color textColor = { 0, 0, 0 };
+	SDL_Color bgColor = { 255, 255, 255 };
+
+	//Open the font and rasterize HUD glyphs in the background, jobs run in order
+	gLoader.submit([=]() -> SDL_Surface*
+	{
+		gFont = openFont(FONT_PATH, 36);
+		if (gFont == NULL)
+		{
+			printf("Failed to load lazy font! SDL_ttf Error: %s\n", TTF_GetError());
+			return NULL;
+		}
+		return gHudAtlas.rasterize(gFont, textColor, bgColor);
+	}, [=](SDL_Surface* surface)
+	{
+		if (surface == NULL || !gHudAtlas.loadFromSurface(surface, gRenderer))
+		{
+			printf("Failed to create HUD glyph atlas!\n");
+			gMediaFailed = true;
+			return;
+		}
+		gTimeLabel.setAtlas(&gHudAtlas);
+		gScoreLabel.setAtlas(&gHudAtlas);
+		gFinalScoreLabel.setFont(gFont, textColor, bgColor);
+		gWinTimeLabel.setFont(gFont, textColor, bgColor);
+	});
+
+	//Static text only needs rendering once
+	gLoader.submit([=]() -> SDL_Surface*
+	{
+		return gFont != NULL ? TTF_RenderText_Shaded(gFont, PLAY_AGAIN_TEXT, textColor, bgColor) : NULL;
+	}, [=](SDL_Surface* surface)
+	{
+		gPlayAgainTexture = gAssets.loadSurface(AssetCache::textKey(PLAY_AGAIN_TEXT, textColor, bgColor, gFont), surface);
+		if (!gPlayAgainTexture.isValid())
+		{
+			printf("Failed to render text texture!\n");
+			gMediaFailed = true;
+		}
+	});
+
+	//Overlay font is optional
+	gLoader.submit([]() -> SDL_Surface*
+	{
+		gOverlayFont = openFont(FONT_PATH, 14);
+		if (gOverlayFont == NULL)
+		{
+			printf("Failed to load overlay font! SDL_ttf Error: %s\n", TTF_GetError());
+		}
+		return NULL;
+	}, [](SDL_Surface*)
+	{
+		gProfiler.setOverlayFont(gOverlayFont);
+	});
+
+	//Color pairs are needed from the first click, which waits for loading to finish
+	gLoader.submit([]() -> SDL_Surface*
+	{
+		gDifficulty.build(MAX_LEVEL + 1, gVision, gPairPolicy);
+		return NULL;
+	}, [](SDL_Surface*)
+	{
+	});
+
+	//Load textures, intro first since it is shown first
+	gLoader.submit([]() -> SDL_Surface*
+	{
+		return loadScreenSurface(INTRO_SCREEN_PATH);
+	}, [](SDL_Surface* surface)
+	{
+		gIntroTexture = gAssets.loadSurface(AssetCache::imageKey(INTRO_SCREEN_PATH), surface);
+		if (!gIntroTexture.isValid())
+		{
+			printf("Failed to load front texture! SDL_image Error: %s\n", IMG_GetError());
+			gMediaFailed = true;
+		}
+	});
+
+	gLoader.submit([]() -> SDL_Surface*
+	{
+		return loadScreenSurface(GAME_OVER_PATH);
+	}, [](SDL_Surface* surface)
+	{
+		gGameOverTexture = gAssets.loadSurface(AssetCache::imageKey(GAME_OVER_PATH), surface);
+		if (!gGameOverTexture.isValid())
+		{
+			printf("Failed to load front texture! SDL_image Error: %s\n", IMG_GetError());
+			gMediaFailed = true;
+		}
+	});
+
+	return true;
+}
+
+void stopRendering()
+{
+	//The thread that created gRenderer frees everything drawn with it
+	if (gRenderThread.joinable())
+	{
+		gRenderStop = true;
+		gRenderQueue.wake();
+		gRenderThread.join();
+	}
+	else
+	{
+		destroyRenderer();
+	}
 }
 
 void close()
 {
-	//Free loaded images
-	gGameOverTexture.free();
-	gIntroTexture.free();
-	gTextTexture.free();
+	stopRendering();
+
+	//Nothing may finish loading after this
+	gLoader.stop();
+
+	//Flush the session log
+	gInput.close();
+
+	//Fonts may read from the archive, close them before unmapping it
+	gProfiler.setOverlayFont(NULL);
+	if (gOverlayFont != NULL)
+		TTF_CloseFont(gOverlayFont);
+	if (gFont != NULL)
+		TTF_CloseFont(gFont);
+	gOverlayFont = NULL;
+	gFont = NULL;
+	gArchive.close();
 
 	//Destroy Window
-	SDL_DestroyRenderer(gRenderer);
 	SDL_DestroyWindow(gWindow);
 	gWindow = NULL;
-	gRenderer = NULL;
+
+	//Capture surface outlives its renderer
+	gCapture.close();
 
 	//Quit SDL subsystems
 	IMG_Quit();
 	SDL_Quit();
 }
+bool handleLayoutEvent(SDL_Event* e)
+{
+	if (e->type == SDL_WINDOWEVENT && e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+	{
+		//Window size is safe to read here, the renderer's output size is not
+		int width, height;
+		SDL_GetWindowSize(gWindow, &width, &height);
+		gLayout.resize(width, height);
+		return true;
+	}
+	return false;
+}
+
+void updateLayoutScale()
+{
+	float scaleX, scaleY;
+	if (gRenderQueue.takeScale(&scaleX, &scaleY))
+	{
+		int width, height;
+		SDL_GetWindowSize(gWindow, &width, &height);
+		gLayout.setScale(scaleX, scaleY);
+		gLayout.resize(width, height);
+	}
+}
+
+void renderPass(Uint32 timeout)
+{
+	IRenderer* gameRenderer = gGameRenderer;
+	bool redraw = false;
+
+	//Upload whatever the loader finished
+	if (gLoader.pump() > 0)
+	{
+		gameRenderer->invalidate();
+		redraw = true;
+	}
+
+	//Copy the frame out so the logic thread can hand over the next one right away
+	RenderFrame* frame = gRenderQueue.acquire(timeout);
+	if (frame != NULL)
+	{
+		if (frame->invalidate || !gHasRenderFrame || frame->state != gRenderFrame.state)
+		{
+			gameRenderer->invalidate();
+		}
+
+		//Layout only changes on resize, a resize may be among the events that did not fit
+		float scaleX = gRenderLayout.getScaleX();
+		float scaleY = gRenderLayout.getScaleY();
+		bool layoutChanged = false;
+		for (int i = 0; i < frame->eventCount; i++)
+		{
+			layoutChanged = gRenderLayout.handleEvent(&frame->events[i], gWindow, gRenderer) || layoutChanged;
+		}
+		if (frame->invalidate)
+		{
+			gRenderLayout.update(gWindow, gRenderer);
+			layoutChanged = true;
+		}
+		if (layoutChanged)
+		{
+			//Scale changes when the window moves to a display with another density
+			gGrid.invalidate();
+			if (gRenderLayout.getScaleX() != scaleX || gRenderLayout.getScaleY() != scaleY)
+			{
+				gRenderQueue.publishScale(gRenderLayout.getScaleX(), gRenderLayout.getScaleY());
+			}
+		}
+
+		//Resizes and lost targets invalidate the retained frame
+		for (int i = 0; i < frame->eventCount; i++)
+		{
+			gScene.handleEvent(&frame->events[i]);
+		}
+
+		//F3 toggles the profiler overlay, F4 writes a trace
+		if (frame->toggleOverlay)
+		{
+			gProfiler.toggleOverlay();
+			gameRenderer->invalidate();
+		}
+		if (frame->exportTrace)
+		{
+			gProfiler.exportChromeTrace("colorgame_trace.json");
+		}
+
+		gRenderFrame = *frame;
+		gHasRenderFrame = true;
+		gRenderQueue.release();
+		redraw = true;
+	}
+
+	if (!redraw || !gHasRenderFrame)
+	{
+		return;
+	}
+
+	const BoardMessage& board = gRenderFrame.board;
+	if (gRenderFrame.state == INTRO_SCREEN)
+	{
+		//Placeholder until the intro screen is uploaded
+		if (gIntroTexture.isValid())
+		{
+			gIntroTexture->render(0, 0, gRenderer);
+		}
+		else
+		{
+			SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			SDL_RenderClear(gRenderer);
+		}
+		SDL_RenderPresent(gRenderer);
+	}
+	else if (gRenderFrame.state == IN_GAME)
+	{
+		//Draw only what changed since the last frame
+		gameRenderer->renderFrame(board);
+	}
+	else if (gRenderFrame.state == GAME_OVER)
+	{
+		gGameOverTexture->render(0, 0, gRenderer);
+		//Render text
+		gFinalScoreLabel.setValue(board.score, gRenderer);
+		gFinalScoreLabel.render(0, 20, gRenderer);
+		SDL_RenderPresent(gRenderer);
+	}
+	else if (gRenderFrame.state == VICTORY_SCREEN)
+	{
+		//Clear screen
+		SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+		SDL_RenderClear(gRenderer);
+
+		gWinTimeLabel.setValue(board.winTimeMs / 1000.0, 2, gRenderer);
+		SDL_Rect boardRect = gRenderLayout.getBoardRect();
+		gWinTimeLabel.render((boardRect.w - gWinTimeLabel.getWidth())/ 2 , boardRect.h / 2, gRenderer);
+
+		gPlayAgainTexture->render((boardRect.w - gPlayAgainTexture->getWidth()) / 2, boardRect.h / 2 + gWinTimeLabel.getHeight(), gRenderer);
+		SDL_RenderPresent(gRenderer);
+	}
+
+	//Clicks are shown now, redraws of the same frame must not count them again
+	for (int i = 0; i < gRenderFrame.clickCount; i++)
+	{
+		gLatency.end(gRenderFrame.clicks[i]);
+	}
+	gRenderFrame.clickCount = 0;
+	gCapture.capture(gRenderFrame.state);
+}
+
+void renderLoop(SDL_sem* ready, bool* created)
+{
+	//SDL renderers may only be used on the thread that created them
+	*created = createRenderer();
+	bool running = *created;
+	SDL_SemPost(ready);
+	if (!running)
+	{
+		return;
+	}
+
+	while (!gRenderStop)
+	{
+		renderPass(RENDER_IDLE_WAIT);
+	}
+	destroyRenderer();
+}
+
 int main(int argc, char* args[])
 {
+	//Boards come from the seed, pass --seed to replay a session
+	//--record writes a session log, --replay plays one back, --fast and --no-render speed it up
+	//--vision simulates a color vision deficiency, --test-vision picks boards it can't tell apart
+	//--grid 8x6 sets the board size, the layout is the one place it is kept
+	//--capture DIR and --golden FILE draw a replay offscreen and dump or check every frame
+	//--latency-csv FILE writes click-to-photon times of every click
+	gLayout.setGrid(GRID_COLUMNS, GRID_ROWS);
+	Uint64 seed = (Uint64)time(NULL);
+	const char* recordPath = NULL;
+	const char* replayPath = NULL;
+	bool fastReplay = false;
+	bool drawEnabled = true;
+	const char* captureDir = NULL;
+	const char* goldenPath = NULL;
+	const char* latencyPath = NULL;
+	CaptureFormat captureFormat = CAPTURE_PNG;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(args[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = strtoull(args[++i], NULL, 10);
+		}
+		else if (strcmp(args[i], "--record") == 0 && i + 1 < argc)
+		{
+			recordPath = args[++i];
+		}
+		else if (strcmp(args[i], "--replay") == 0 && i + 1 < argc)
+		{
+			replayPath = args[++i];
+		}
+		else if (strcmp(args[i], "--fast") == 0)
+		{
+			fastReplay = true;
+		}
+		else if (strcmp(args[i], "--no-render") == 0)
+		{
+			drawEnabled = false;
+		}
+		else if (strcmp(args[i], "--grid") == 0 && i + 1 < argc)
+		{
+			int columns, rows;
+			if (!BoardLayout::parseGrid(args[++i], &columns, &rows))
+			{
+				printf("Invalid grid %s, expected columns x rows up to %dx%d\n", args[i], MAX_GRID_SIZE, MAX_GRID_SIZE);
+				return 1;
+			}
+			gLayout.setGrid(columns, rows);
+		}
+		else if (strcmp(args[i], "--capture") == 0 && i + 1 < argc)
+		{
+			captureDir = args[++i];
+		}
+		else if (strcmp(args[i], "--capture-raw") == 0)
+		{
+			captureFormat = CAPTURE_RAW;
+		}
+		else if (strcmp(args[i], "--golden") == 0 && i + 1 < argc)
+		{
+			goldenPath = args[++i];
+		}
+		else if (strcmp(args[i], "--latency-csv") == 0 && i + 1 < argc)
+		{
+			latencyPath = args[++i];
+		}
+		else if (strcmp(args[i], "--vision") == 0 && i + 1 < argc)
+		{
+			gVision = parseColorDeficiency(args[++i]);
+			gPairPolicy = PAIRS_VISIBLE;
+			gSimulateVision = true;
+		}
+		else if (strcmp(args[i], "--test-vision") == 0 && i + 1 < argc)
+		{
+			gVision = parseColorDeficiency(args[++i]);
+			gPairPolicy = PAIRS_CONFUSING;
+			gSimulateVision = false;
+		}
+	}
+
+	//Replays bring their own seed and board
+	if (replayPath != NULL)
+	{
+		if (!gInput.startReplay(replayPath, fastReplay))
+		{
+			return 1;
+		}
+		seed = gInput.getSeed();
+		gLayout.setGrid(gInput.getColumns(), gInput.getRows());
+		gScheduler.setDrawEnabled(drawEnabled);
+		gDrawEnabled = drawEnabled;
+	}
+
+	//Offscreen frames have no window to click, so they come from a replay
+	if (captureDir != NULL || goldenPath != NULL)
+	{
+		if (replayPath == NULL)
+		{
+			printf("--capture and --golden need --replay\n");
+			return 1;
+		}
+		gCapture.enable(captureDir != NULL ? captureDir : "", captureFormat);
+		if (goldenPath != NULL && !gCapture.loadGolden(goldenPath))
+		{
+			return 1;
+		}
+	}
+
 	if (!init())
 	{
 		cout << "Failed to initialize!" << endl;
@@ -293,274 +857,197 @@ int main(int argc, char* args[])
 			//main loop flag
 			int game_state = INTRO_SCREEN;
 			
-			//Starting screen width and height
-			int width = SCREEN_WIDTH;
-			int height = SCREEN_HEIGHT;
-
-			//color components
-			Uint8 r = 0;
-			Uint8 g = 255;
-			Uint8 b = 255;
-			Uint8 a = 255;
-
-			//the selected box
-			int selected = 0;
-			int rgbRand = 1;
-			int decreaseAmount = 128;
+			if (replayPath != NULL)
+			{
+				gInput.setWindow(gWindow);
+			}
+			else if (recordPath != NULL)
+			{
+				gInput.startRecording(recordPath, seed, gLayout.getColumns(), gLayout.getRows());
+			}
+			gScheduler.setInputLog(&gInput);
+			printf("Seed: %llu\n", (unsigned long long)seed);
 
-			//initialize rand
-			srand(time(NULL));
+			//Game rules and state, drawn on the render thread
+			GameSession session(0, gLayout.getColumns(), gLayout.getRows(), seed, &gDifficulty);
+			ColorGameEngine& engine = session.getEngine();
+			gLatency.setProfiler(&gProfiler);
+			bool renderThreaded = gRenderThread.joinable();
 
-			//initialize game variables
-			int score = 0;
-			int level = 0;
-			int winTime = 0;
+			//Logged sessions start once loading is done, so early clicks can't play out differently
+			if (gInput.getMode() != INPUT_LIVE)
+			{
+				while (!gLoader.isIdle() && !gMediaFailed)
+				{
+					//Uploads run wherever gRenderer lives
+					if (renderThreaded)
+					{
+						gRenderQueue.wake();
+					}
+					else
+					{
+						gLoader.pump();
+					}
+					SDL_Delay(1);
+				}
+			}
+			gInput.startClock();
+			Uint32 replayStart = SDL_GetTicks();
 
-			//initalize timer
-			Uint32 startTimer = 0;
+			//Event handler
+			SDL_Event e;
 
-			//score stream and timer stream
-			stringstream scoreText;
-			stringstream timeText;
+			//State the scheduler is currently pacing
+			int frameState = -1;
 
-			//Event handler
-			SDL_Event e;;
+			//Last frame could not be handed over yet
+			bool framePending = false;
 
 			while (!(game_state == QUIT_GAME))
 			{
-				if (game_state == INTRO_SCREEN)
+				//Every loop iteration is one frame
+				ProfileScope frameScope(&gProfiler, PROFILE_FRAME);
+
+				if (gMediaFailed)
 				{
-					while (SDL_PollEvent(&e) != 0)
-					{
-						//User requests quit
-						if (e.type == SDL_QUIT)
-						{
-							game_state = QUIT_GAME;
-						}
-						for (int i = 0; i < TOTAL_BUTTONS; i++)
-						{
-							if (gButtons[i].handleEvent(&e))
-							{
-								game_state = IN_GAME;
-							}
-						}
-					}
-					gIntroTexture.render(0, 0, gRenderer);
-					SDL_RenderPresent(gRenderer);
+					cout << "Failed to load media!" << endl;
+					game_state = QUIT_GAME;
+					break;
 				}
-				else if (game_state == IN_GAME)
+
+				//Switch pacing when the state changes
+				if (game_state != frameState)
 				{
-					//Handle events on queue
-					while (SDL_PollEvent(&e) != 0)
+					ProfileScope stateScope(&gProfiler, PROFILE_STATE);
+					frameState = game_state;
+					gInput.recordState(game_state);
+					gScheduler.setMode(game_state == IN_GAME ? IN_GAME_FRAME_MODE : FRAME_EVENT_DRIVEN, TARGET_FPS);
+				}
+
+				//Replay ends with its log
+				if (gInput.isReplayFinished())
+				{
+					printf("Replay finished: %u ms of play in %u ms\n", gInput.getTicks(), SDL_GetTicks() - replayStart);
+					game_state = QUIT_GAME;
+					break;
+				}
+
+				//A new display density only changes how points map to pixels
+				updateLayoutScale();
+
+				//Everything this frame changes is recorded for the render thread
+				RenderFrame* frame = gRenderQueue.record();
+
+				//Handle events on queue
+				while (gScheduler.pollEvent(&e))
+				{
+					ProfileScope eventScope(&gProfiler, PROFILE_EVENTS);
+
+					//User requests quit
+					if (e.type == SDL_QUIT)
 					{
-						//User requests quit
-						if (e.type == SDL_QUIT)
-						{
-							game_state = QUIT_GAME;
-						}
-	
-						//Handle user selection
-						int boxClicked = -1;
-						for (int i = 0; i < TOTAL_BUTTONS; i++)
+						session.quit();
+					}
+
+					//Layout only changes on resize, clicks right after one already map to the new board
+					handleLayoutEvent(&e);
+
+					//Resizes and lost targets go to the render thread for the layout and the retained frame
+					if (e.type == SDL_WINDOWEVENT || e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)
+					{
+						if (frame->eventCount < RENDER_MAX_EVENTS)
 						{
-							if (gButtons[i].handleEvent(&e))
-							{
-								boxClicked = i;
-							}
+							frame->events[frame->eventCount++] = e;
 						}
-						if (boxClicked >= 0)
+						else
 						{
-
-							if (boxClicked == selected)
-							{
-								r = rand() % 256;
-								g = rand() % 256;
-								b = rand() % 256;
-								a = rand() % 256;
-								selected = rand() % 9;
-
-								//rgbRand = rand() % 3;
-									
-								decreaseAmount = DIFFICULTY - level; // + rand() % 16
-								score++;
-								if (!(level >= MAX_LEVEL))
-								{
-									level++;
-									cout << "Level " << level << " Score: " << score << endl;
-								}
-								else //You win at level MAXLEVEL
-								{
-									level == MAX_LEVEL;
-									winTime = (SDL_GetTicks() - startTimer) / 1000;
-									game_state = VICTORY_SCREEN;
-								}
-							}
-							else
-							{
-								game_state = GAME_OVER;
-							}
+							frame->invalidate = true;
 						}
 					}
 
-					//Clear screen
-					SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-					SDL_RenderClear(gRenderer);
-
-					SDL_Rect colorBox[9];
-					colorBox[0] = { 0, 0, width / 3, height / 3 };
-					colorBox[1] = { width / 3, 0, width / 3, height / 3 };
-					colorBox[2] = { width * 2 / 3, 0, width / 3, height / 3 };
-					colorBox[3] = { 0, height / 3, width / 3, height / 3 };
-					colorBox[4] = { width / 3, height / 3, width / 3, height / 3 };
-					colorBox[5] = { width * 2 / 3, height / 3, width / 3, height / 3 };
-					colorBox[6] = { 0, 2 * height / 3, width / 3, height / 3 };
-					colorBox[7] = { width / 3, 2 * height / 3, width / 3, height / 3 };
-					colorBox[8] = { width * 2 / 3, 2 * height / 3, width / 3, height / 3 };
-
-					SDL_SetRenderDrawColor(gRenderer, r, g, b, a);
-					for (int i = 0; i < 9; i++)
+					//F3 toggles the profiler overlay, F4 writes a trace
+					if (game_state == IN_GAME && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3)
 					{
-						SDL_RenderFillRect(gRenderer, &colorBox[i]);
+						frame->toggleOverlay = !frame->toggleOverlay;
 					}
-					/* randomly decrease the color of selected box
-					switch (rgbRand)
-					{
-					case 0:
-						SDL_SetRenderDrawColor(gRenderer, r - decreaseAmount, g, b, a);
-					case 1:
-						SDL_SetRenderDrawColor(gRenderer, r, g - decreaseAmount, b, a);
-					case 2:
-						SDL_SetRenderDrawColor(gRenderer, r, g, b - decreaseAmount, a);
-					}*/
-
-					//find the max r,g,b color and decrease it 
-					if (r >= g && r >= b)
-						SDL_SetRenderDrawColor(gRenderer, r - decreaseAmount, g, b, a);
-					else if (g >= r && g >= b)
-						SDL_SetRenderDrawColor(gRenderer, r, g - decreaseAmount, b, a);
-					else if (b >= r && b >= g)
-						SDL_SetRenderDrawColor(gRenderer, r, g, b - decreaseAmount, a);
-					SDL_RenderFillRect(gRenderer, &colorBox[selected]);
-
-					SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-					for (int i = 0; i < 9; i++)
+					else if (game_state == IN_GAME && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F4)
 					{
-						SDL_RenderDrawRect(gRenderer, &colorBox[i]);
+						frame->exportTrace = true;
 					}
 
-					//render score and time
-					SDL_Color textColor = { 0, 0, 0 };
-					SDL_Color bgColor = { 255, 255, 255 };
-					timeText.str("");
-					timeText << "Time: " << (SDL_GetTicks() - startTimer) / 1000;
-					//print timer
-					gTextTexture.loadFromRenderedText(timeText.str().c_str(), textColor, bgColor, gFont, gRenderer);
-					gTextTexture.render(0, SCREEN_HEIGHT, gRenderer);
-					//print score
-					scoreText.str("");
-					scoreText << "Score: " << score;
-					gTextTexture.loadFromRenderedText(scoreText.str().c_str(), textColor, bgColor, gFont, gRenderer);
-					gTextTexture.render(150, SCREEN_HEIGHT, gRenderer);
-
-					SDL_RenderPresent(gRenderer);
-
-					SDL_RenderPresent(gRenderer);
-				}
-				else if (game_state == GAME_OVER)
-				{
-					while (SDL_PollEvent(&e) != 0)
+					//Game can only start once everything is loaded
+					int round = engine.getRound();
+					if (game_state != INTRO_SCREEN || gLoader.isIdle())
 					{
-						//User requests quit
-						if (e.type == SDL_QUIT)
+						ClickResult result = session.click(gHitTest.handleEvent(&e), gInput.getEventMicros());
+						if (result == CLICK_CORRECT)
 						{
-							game_state = QUIT_GAME;
+							cout << "Level " << engine.getLevel() << " Score: " << engine.getScore() << " DeltaE: " << engine.getDeltaE()
+								<< " Reaction: " << engine.getReactionStats().getLastMs() << " ms" << endl;
 						}
-						//restart the game
-						for (int i = 0; i < TOTAL_BUTTONS; i++)
+						else if (result == CLICK_VICTORY || result == CLICK_WRONG)
 						{
-							if (gButtons[i].handleEvent(&e))
+							//End of game stats
+							if (result == CLICK_VICTORY)
 							{
-								game_state = INTRO_SCREEN;
-								score = 0;
-								level = 0;
-								startTimer = SDL_GetTicks();
-
-								//Clear screen
-								SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-								SDL_RenderClear(gRenderer);
-
-								r = 0;
-								g = 255;
-								b = 255;
-								a = 255;
-
-								selected = 0;
+								printf("Won in %.3f seconds\n", engine.getWinTime());
 							}
+							engine.getReactionStats().printSummary();
 						}
 					}
-					gGameOverTexture.render(0, 0, gRenderer);
-					//Render text
-					SDL_Color textColor = { 0, 0, 0 };
-					SDL_Color bgColor = { 255, 255, 255 };
-					scoreText.str("");
-					scoreText << "Your final score: " << score;
-					gTextTexture.loadFromRenderedText(scoreText.str().c_str(), textColor, bgColor, gFont, gRenderer);
-
-					gTextTexture.loadFromRenderedText(scoreText.str().c_str(), textColor, bgColor, gFont, gRenderer);
-					gTextTexture.render(0, 20, gRenderer);
-					SDL_RenderPresent(gRenderer);
-				}
-				else if (game_state = VICTORY_SCREEN)
-				{
-					while (SDL_PollEvent(&e) != 0)
+
+					//Time clicks that change the screen, replayed events carry no real timestamp
+					if (e.type == SDL_MOUSEBUTTONUP && gInput.getMode() != INPUT_REPLAY && frame->clickCount < RENDER_MAX_CLICKS
+						&& (engine.getRound() != round || session.getState() != game_state))
 					{
-						//User requests quit
-						if (e.type == SDL_QUIT)
-						{
-							game_state = QUIT_GAME;
-						}
-						//restart the game
-						for (int i = 0; i < TOTAL_BUTTONS; i++) 
-						{
-							if (gButtons[i].handleEvent(&e))
-							{
-								game_state = INTRO_SCREEN;
-								score = 0;
-								level = 0;
-								startTimer = SDL_GetTicks();
+						frame->clicks[frame->clickCount++] = LatencyTracker::begin(e.button.timestamp, engine.getRound(), session.getState());
+					}
+					game_state = session.getState();
+				}
 
-								//Clear screen
-								SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-								SDL_RenderClear(gRenderer);
+				//Nothing to draw until something happens, or the render thread takes a frame that is still waiting
+				if (!gScheduler.shouldDraw() && !framePending)
+				{
+					continue;
+				}
 
-								r = 0;
-								g = 255;
-								b = 255;
-								a = 255;
+				//Hand the board over, drawing and presenting happen on the render thread
+				if (game_state == IN_GAME)
+				{
+					engine.step(gInput.getMicros());
+				}
+				frame->state = game_state;
+				session.writeBoard(&frame->board);
 
-								selected = 0;
-							}
-						}
-					}
-					//Clear screen
-					SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-					SDL_RenderClear(gRenderer);
-
-					SDL_Color textColor = { 0, 0, 0 };
-					SDL_Color bgColor = { 255, 255, 255 };
-					timeText.str("");
-					timeText << "You won in: " << winTime << " seconds!";
-					gTextTexture.loadFromRenderedText(timeText.str().c_str(), textColor, bgColor, gFont, gRenderer);
-					gTextTexture.render((SCREEN_WIDTH - gTextTexture.getWidth())/ 2 , SCREEN_HEIGHT / 2, gRenderer);
-
-					gTextTexture.loadFromRenderedText("Click anywhere to play again!", textColor, bgColor, gFont, gRenderer);
-					gTextTexture.render((SCREEN_WIDTH - gTextTexture.getWidth()) / 2, SCREEN_HEIGHT / 2 + gTextTexture.getHeight(), gRenderer);
-					SDL_RenderPresent(gRenderer);
+				//Render thread is still busy with the last frame, this one keeps recording and goes out
+				//once the release event wakes the loop, input is never held up waiting for it
+				framePending = !gRenderQueue.submit();
+				if (!renderThreaded)
+				{
+					renderPass(0);
 				}
+				gScheduler.frameDone();
+			}
+
+			//Latency is written by the render thread until it stops
+			stopRendering();
+			gLatency.printSummary();
+			if (latencyPath != NULL)
+			{
+				gLatency.exportCsv(latencyPath);
 			}
 		}
 	}
 
+	//Init may have started the render thread before failing
+	stopRendering();
+
+	//Frames that drifted from the golden run fail the run
+	if (!gCapture.report())
+	{
+		return 1;
+	}
+
 	int pause;
 	return 0;
 }
\ No newline at end of file
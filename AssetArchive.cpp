@@ -0,0 +1,258 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "AssetArchive.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::AssetArchive()
+{
+	//initialize
+	mData = NULL;
+	mSize = 0;
+#ifdef _WIN32
+	mFile = NULL;
+	mMapping = NULL;
+#endif
+	mEntries = NULL;
+	mEntryCount = 0;
+}
+
+AssetArchive::~AssetArchive()
+{
+	//Deallocates memory, calls close
+	close();
+}
+
+bool AssetArchive::open(std::string path)
+{
+	//Get rid of preexisting mapping
+	close();
+
+	//Map the whole file once, no reads or copies afterwards
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = NULL;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+	{
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	}
+	if (mapping == NULL)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	mFile = file;
+	mMapping = mapping;
+	mData = (const Uint8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	mSize = (size_t)fileSize.QuadPart;
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		::close(file);
+		return false;
+	}
+	void* data = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+	//Mapping stays valid after the descriptor is closed
+	::close(file);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	mData = (const Uint8*)data;
+	mSize = (size_t)fileStat.st_size;
+#endif
+
+	if (mData == NULL)
+	{
+		close();
+		return false;
+	}
+
+	//Check header and entry table
+	const AssetArchiveHeader* header = (const AssetArchiveHeader*)mData;
+	if (mSize < sizeof(AssetArchiveHeader) || memcmp(header->magic, ASSET_ARCHIVE_MAGIC, 4) != 0 || header->version != ASSET_ARCHIVE_VERSION ||
+		header->entryCount > (mSize - sizeof(AssetArchiveHeader)) / sizeof(AssetArchiveEntry))
+	{
+		printf("Invalid asset archive %s\n", path.c_str());
+		close();
+		return false;
+	}
+	mEntries = (const AssetArchiveEntry*)(mData + sizeof(AssetArchiveHeader));
+	mEntryCount = header->entryCount;
+	for (Uint32 i = 0; i < mEntryCount; i++)
+	{
+		if (mEntries[i].offset > mSize || mEntries[i].size > mSize - mEntries[i].offset)
+		{
+			printf("Invalid asset archive %s\n", path.c_str());
+			close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void AssetArchive::close()
+{
+	if (mData != NULL)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(mData);
+#else
+		munmap((void*)mData, mSize);
+#endif
+	}
+#ifdef _WIN32
+	if (mMapping != NULL)
+		CloseHandle((HANDLE)mMapping);
+	if (mFile != NULL)
+		CloseHandle((HANDLE)mFile);
+	mMapping = NULL;
+	mFile = NULL;
+#endif
+	mData = NULL;
+	mSize = 0;
+	mEntries = NULL;
+	mEntryCount = 0;
+}
+
+bool AssetArchive::isOpen()
+{
+	return mData != NULL;
+}
+
+bool AssetArchive::find(std::string name, const void** data, size_t* size)
+{
+	std::string base = baseName(name);
+	for (Uint32 i = 0; i < mEntryCount; i++)
+	{
+		if (strncmp(mEntries[i].name, base.c_str(), ASSET_ARCHIVE_NAME_LENGTH) == 0)
+		{
+			*data = mData + mEntries[i].offset;
+			*size = (size_t)mEntries[i].size;
+			return true;
+		}
+	}
+	return false;
+}
+
+SDL_RWops* AssetArchive::openRW(std::string name)
+{
+	const void* data;
+	size_t size;
+	if (!find(name, &data, &size))
+	{
+		return NULL;
+	}
+
+	//Stream reads straight out of the mapping
+	return SDL_RWFromConstMem(data, (int)size);
+}
+
+std::string AssetArchive::baseName(std::string path)
+{
+	size_t slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool AssetArchive::pack(std::string path, const std::vector<std::string>& files)
+{
+	//Read every input first so offsets are known
+	std::vector< std::vector<char> > contents(files.size());
+	std::vector<AssetArchiveEntry> entries(files.size());
+	Uint64 offset = sizeof(AssetArchiveHeader) + files.size() * sizeof(AssetArchiveEntry);
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		std::string name = baseName(files[i]);
+		if (name.size() >= (size_t)ASSET_ARCHIVE_NAME_LENGTH)
+		{
+			printf("Asset name too long: %s\n", name.c_str());
+			return false;
+		}
+
+		FILE* input = fopen(files[i].c_str(), "rb");
+		if (input == NULL)
+		{
+			printf("Unable to open %s\n", files[i].c_str());
+			return false;
+		}
+		fseek(input, 0, SEEK_END);
+		long length = ftell(input);
+		fseek(input, 0, SEEK_SET);
+		contents[i].resize(length > 0 ? (size_t)length : 0);
+		if (length > 0 && fread(&contents[i][0], 1, (size_t)length, input) != (size_t)length)
+		{
+			printf("Unable to read %s\n", files[i].c_str());
+			fclose(input);
+			return false;
+		}
+		fclose(input);
+
+		memset(&entries[i], 0, sizeof(AssetArchiveEntry));
+		strncpy(entries[i].name, name.c_str(), ASSET_ARCHIVE_NAME_LENGTH - 1);
+		offset = (offset + ASSET_ARCHIVE_ALIGN - 1) / ASSET_ARCHIVE_ALIGN * ASSET_ARCHIVE_ALIGN;
+		entries[i].offset = offset;
+		entries[i].size = contents[i].size();
+		offset += contents[i].size();
+	}
+
+	FILE* output = fopen(path.c_str(), "wb");
+	if (output == NULL)
+	{
+		printf("Unable to write %s\n", path.c_str());
+		return false;
+	}
+
+	AssetArchiveHeader header;
+	memcpy(header.magic, ASSET_ARCHIVE_MAGIC, 4);
+	header.version = ASSET_ARCHIVE_VERSION;
+	header.entryCount = (Uint32)files.size();
+	header.reserved = 0;
+	fwrite(&header, sizeof(header), 1, output);
+	if (!entries.empty())
+	{
+		fwrite(&entries[0], sizeof(AssetArchiveEntry), entries.size(), output);
+	}
+
+	//Pad each file to its aligned offset
+	Uint64 written = sizeof(AssetArchiveHeader) + files.size() * sizeof(AssetArchiveEntry);
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		while (written < entries[i].offset)
+		{
+			fputc(0, output);
+			written++;
+		}
+		if (!contents[i].empty())
+		{
+			fwrite(&contents[i][0], 1, contents[i].size(), output);
+		}
+		written += contents[i].size();
+	}
+
+	bool success = ferror(output) == 0;
+	fclose(output);
+	return success;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+//Packed asset archive layout, all fields little endian
+//Header, then entryCount entries, then file data aligned to ASSET_ARCHIVE_ALIGN
+const char ASSET_ARCHIVE_MAGIC[4] = { 'C', 'G', 'P', 'K' };
+const Uint32 ASSET_ARCHIVE_VERSION = 1;
+const int ASSET_ARCHIVE_NAME_LENGTH = 112;
+const int ASSET_ARCHIVE_ALIGN = 16;
+
+struct AssetArchiveHeader
+{
+	char magic[4];
+	Uint32 version;
+	Uint32 entryCount;
+	Uint32 reserved;
+};
+
+struct AssetArchiveEntry
+{
+	//File name without directories, zero padded
+	char name[ASSET_ARCHIVE_NAME_LENGTH];
+	Uint64 offset;
+	Uint64 size;
+};
+
+//Read-only, memory-mapped asset archive
+//Data handed out points straight into the mapping, so the archive must outlive it
+class AssetArchive
+{
+public:
+	//Initializes variables
+	AssetArchive();
+
+	//Deallocates memory, calls close
+	~AssetArchive();
+
+	//Maps the archive and checks its table, returns false if missing or invalid
+	bool open(std::string path);
+
+	//Unmaps the archive
+	void close();
+
+	//Checks if an archive is mapped
+	bool isOpen();
+
+	//Finds a file by name, directories in the name are ignored
+	bool find(std::string name, const void** data, size_t* size);
+
+	//Opens a file as a read-only SDL stream over the mapping, NULL if not found
+	SDL_RWops* openRW(std::string name);
+
+	//Writes an archive of the given files, used by the packer tool
+	static bool pack(std::string path, const std::vector<std::string>& files);
+
+	//Gets file name without directories
+	static std::string baseName(std::string path);
+
+private:
+	//Mapped file
+	const Uint8* mData;
+	size_t mSize;
+
+#ifdef _WIN32
+	void* mFile;
+	void* mMapping;
+#endif
+
+	//Entry table inside the mapping
+	const AssetArchiveEntry* mEntries;
+	Uint32 mEntryCount;
+};
@@ -0,0 +1,224 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include "AssetCache.h"
+
+TextureHandle::TextureHandle()
+{
+	mEntry = NULL;
+}
+
+TextureHandle::~TextureHandle()
+{
+	release();
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other)
+{
+	mEntry = other.mEntry;
+	other.mEntry = NULL;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle&& other)
+{
+	if (this != &other)
+	{
+		release();
+		mEntry = other.mEntry;
+		other.mEntry = NULL;
+	}
+	return *this;
+}
+
+void TextureHandle::release()
+{
+	if (mEntry != NULL)
+	{
+		mEntry->refCount--;
+		mEntry = NULL;
+	}
+}
+
+LTexture* TextureHandle::get()
+{
+	return mEntry != NULL ? &mEntry->texture : NULL;
+}
+
+LTexture* TextureHandle::operator->()
+{
+	return get();
+}
+
+bool TextureHandle::isValid()
+{
+	return mEntry != NULL;
+}
+
+AssetCache::AssetCache(size_t budgetBytes)
+{
+	mRenderer = NULL;
+	mBudgetBytes = budgetBytes;
+	mUsedBytes = 0;
+	mUseClock = 0;
+}
+
+AssetCache::~AssetCache()
+{
+	clear();
+}
+
+void AssetCache::setRenderer(SDL_Renderer* gRenderer)
+{
+	mRenderer = gRenderer;
+}
+
+AssetEntry* AssetCache::find(const std::string& key)
+{
+	std::unordered_map<std::string, AssetEntry*>::iterator found = mEntries.find(key);
+	return found != mEntries.end() ? found->second : NULL;
+}
+
+TextureHandle AssetCache::acquire(AssetEntry* entry)
+{
+	TextureHandle handle;
+	entry->refCount++;
+	entry->lastUse = ++mUseClock;
+	handle.mEntry = entry;
+	return handle;
+}
+
+TextureHandle AssetCache::insert(const std::string& key, LTexture& texture)
+{
+	AssetEntry* entry = new AssetEntry();
+	entry->key = key;
+	entry->texture = std::move(texture);
+	entry->refCount = 0;
+
+	//Textures are 32 bits per pixel once uploaded
+	entry->bytes = (size_t)entry->texture.getWidth() * entry->texture.getHeight() * 4;
+	entry->lastUse = 0;
+
+	mEntries[key] = entry;
+	mUsedBytes += entry->bytes;
+
+	TextureHandle handle = acquire(entry);
+	evict();
+	return handle;
+}
+
+std::string AssetCache::imageKey(const std::string& path)
+{
+	return "image:" + path;
+}
+
+std::string AssetCache::textKey(const std::string& text, SDL_Color textColor, SDL_Color bgColor, TTF_Font* gFont)
+{
+	//Same text with other colors or font is another texture
+	char params[64];
+	snprintf(params, sizeof(params), "text:%p:%02x%02x%02x:%02x%02x%02x:", (void*)gFont,
+		textColor.r, textColor.g, textColor.b, bgColor.r, bgColor.g, bgColor.b);
+	return params + text;
+}
+
+TextureHandle AssetCache::loadImage(const std::string& path)
+{
+	std::string key = imageKey(path);
+	AssetEntry* entry = find(key);
+	if (entry != NULL)
+	{
+		return acquire(entry);
+	}
+
+	LTexture texture;
+	if (!texture.loadFromFile(path, mRenderer))
+	{
+		return TextureHandle();
+	}
+	return insert(key, texture);
+}
+
+TextureHandle AssetCache::loadText(const std::string& text, SDL_Color textColor, SDL_Color bgColor, TTF_Font* gFont)
+{
+	std::string key = textKey(text, textColor, bgColor, gFont);
+	AssetEntry* entry = find(key);
+	if (entry != NULL)
+	{
+		return acquire(entry);
+	}
+
+	LTexture texture;
+	if (!texture.loadFromRenderedText(text, textColor, bgColor, gFont, mRenderer))
+	{
+		return TextureHandle();
+	}
+	return insert(key, texture);
+}
+
+TextureHandle AssetCache::loadSurface(const std::string& key, SDL_Surface* surface)
+{
+	AssetEntry* entry = find(key);
+	if (entry != NULL)
+	{
+		return acquire(entry);
+	}
+
+	LTexture texture;
+	if (surface == NULL || !texture.loadFromSurface(surface, mRenderer))
+	{
+		return TextureHandle();
+	}
+	return insert(key, texture);
+}
+
+void AssetCache::setBudget(size_t budgetBytes)
+{
+	mBudgetBytes = budgetBytes;
+	evict();
+}
+
+size_t AssetCache::getUsedBytes()
+{
+	return mUsedBytes;
+}
+
+void AssetCache::evict()
+{
+	while (mUsedBytes > mBudgetBytes)
+	{
+		//Least recently used texture nobody holds
+		std::unordered_map<std::string, AssetEntry*>::iterator oldest = mEntries.end();
+		for (std::unordered_map<std::string, AssetEntry*>::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+		{
+			if (it->second->refCount == 0 && (oldest == mEntries.end() || it->second->lastUse < oldest->second->lastUse))
+			{
+				oldest = it;
+			}
+		}
+
+		//Everything left is in use
+		if (oldest == mEntries.end())
+		{
+			break;
+		}
+
+		mUsedBytes -= oldest->second->bytes;
+		delete oldest->second;
+		mEntries.erase(oldest);
+	}
+}
+
+void AssetCache::clear()
+{
+	for (std::unordered_map<std::string, AssetEntry*>::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+	{
+		if (it->second->refCount > 0)
+		{
+			printf("Asset %s freed while still referenced\n", it->first.c_str());
+		}
+		delete it->second;
+	}
+	mEntries.clear();
+	mUsedBytes = 0;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+#include "LTexture.h"
+
+//Cached texture shared by every handle to it
+struct AssetEntry
+{
+	std::string key;
+	LTexture texture;
+	int refCount;
+	size_t bytes;
+	Uint64 lastUse;
+};
+
+class AssetCache;
+
+//Move-only reference to a cached texture, keeps it from being evicted
+class TextureHandle
+{
+public:
+	//Initializes an empty handle
+	TextureHandle();
+
+	//Drops the reference
+	~TextureHandle();
+
+	//Handles move, copies would miscount references
+	TextureHandle(TextureHandle&& other);
+	TextureHandle& operator=(TextureHandle&& other);
+	TextureHandle(const TextureHandle&) = delete;
+	TextureHandle& operator=(const TextureHandle&) = delete;
+
+	//Drops the reference early
+	void release();
+
+	//Gets the texture, NULL for an empty handle
+	LTexture* get();
+	LTexture* operator->();
+	bool isValid();
+
+private:
+	friend class AssetCache;
+
+	//Referenced entry
+	AssetEntry* mEntry;
+};
+
+//Loads each texture once, keyed by path or by text render parameters
+//Textures nobody references are evicted oldest first once over the budget
+//The cache must outlive its handles
+class AssetCache
+{
+public:
+	//Initializes an empty cache with a GPU memory budget in bytes
+	AssetCache(size_t budgetBytes = 64 * 1024 * 1024);
+
+	//Deallocates memory, calls clear
+	~AssetCache();
+
+	//Sets renderer textures are created on
+	void setRenderer(SDL_Renderer* gRenderer);
+
+	//Gets image at path, decoding it only on first use
+	TextureHandle loadImage(const std::string& path);
+
+	//Gets rendered text, rasterizing it only on first use
+	TextureHandle loadText(const std::string& text, SDL_Color textColor, SDL_Color bgColor, TTF_Font* gFont);
+
+	//Gets texture for a key, uploading the already decoded surface only on first use
+	TextureHandle loadSurface(const std::string& key, SDL_Surface* surface);
+
+	//Gets cache keys, for surfaces decoded elsewhere
+	static std::string imageKey(const std::string& path);
+	static std::string textKey(const std::string& text, SDL_Color textColor, SDL_Color bgColor, TTF_Font* gFont);
+
+	//Sets budget and evicts down to it
+	void setBudget(size_t budgetBytes);
+
+	//Gets estimated GPU memory in use
+	size_t getUsedBytes();
+
+	//Evicts unreferenced textures until within budget
+	void evict();
+
+	//Frees every texture, handles must be released first
+	void clear();
+
+private:
+	//Returns a handle to a cached entry, or NULL if not cached
+	AssetEntry* find(const std::string& key);
+
+	//Adds a loaded texture and returns a handle to it
+	TextureHandle insert(const std::string& key, LTexture& texture);
+
+	//Makes a new handle to an entry
+	TextureHandle acquire(AssetEntry* entry);
+
+	//Renderer for new textures
+	SDL_Renderer* mRenderer;
+
+	//Cached textures by key
+	std::unordered_map<std::string, AssetEntry*> mEntries;
+
+	//Memory accounting
+	size_t mBudgetBytes;
+	size_t mUsedBytes;
+
+	//Use counter for least recently used eviction
+	Uint64 mUseClock;
+};
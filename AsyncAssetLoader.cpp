@@ -0,0 +1,140 @@
+#include <SDL.h>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "AsyncAssetLoader.h"
+
+AsyncAssetLoader::AsyncAssetLoader()
+{
+	mStarted = false;
+	mStopping = false;
+	mOutstanding = 0;
+	mEventType = (Uint32)-1;
+}
+
+AsyncAssetLoader::~AsyncAssetLoader()
+{
+	stop();
+}
+
+void AsyncAssetLoader::submit(std::function<SDL_Surface*()> decode, std::function<void(SDL_Surface*)> upload)
+{
+	//Event type can only be registered once SDL is up
+	if (mEventType == (Uint32)-1)
+	{
+		mEventType = SDL_RegisterEvents(1);
+	}
+
+	AssetJob job;
+	job.decode = decode;
+	job.upload = upload;
+	job.surface = NULL;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mPending.push_back(job);
+		mOutstanding++;
+		mStopping = false;
+	}
+	mWake.notify_one();
+
+	if (!mStarted)
+	{
+		mStarted = true;
+		mWorker = std::thread(&AsyncAssetLoader::workerLoop, this);
+	}
+}
+
+void AsyncAssetLoader::workerLoop()
+{
+	while (true)
+	{
+		AssetJob job;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWake.wait(lock, [this] { return mStopping || !mPending.empty(); });
+			if (mStopping)
+			{
+				return;
+			}
+			job = mPending.front();
+			mPending.pop_front();
+		}
+
+		//Disk reads and decoding happen here, away from the render thread
+		job.surface = job.decode();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mCompleted.push_back(job);
+		}
+
+		//Wake the main loop so it can upload
+		if (mEventType != (Uint32)-1)
+		{
+			SDL_Event e;
+			SDL_memset(&e, 0, sizeof(e));
+			e.type = mEventType;
+			SDL_PushEvent(&e);
+		}
+	}
+}
+
+int AsyncAssetLoader::pump()
+{
+	//Take the finished jobs out under the lock, upload without it
+	std::deque<AssetJob> completed;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		completed.swap(mCompleted);
+	}
+
+	for (int i = 0; i < (int)completed.size(); i++)
+	{
+		completed[i].upload(completed[i].surface);
+		if (completed[i].surface != NULL)
+		{
+			SDL_FreeSurface(completed[i].surface);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mOutstanding -= (int)completed.size();
+	return (int)completed.size();
+}
+
+bool AsyncAssetLoader::isIdle()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mOutstanding == 0;
+}
+
+Uint32 AsyncAssetLoader::getEventType()
+{
+	return mEventType;
+}
+
+void AsyncAssetLoader::stop()
+{
+	if (mStarted)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mWake.notify_all();
+		mWorker.join();
+		mStarted = false;
+	}
+
+	//Nothing will upload these any more
+	for (int i = 0; i < (int)mCompleted.size(); i++)
+	{
+		if (mCompleted[i].surface != NULL)
+			SDL_FreeSurface(mCompleted[i].surface);
+	}
+	mCompleted.clear();
+	mPending.clear();
+	mOutstanding = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SDL.h>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//Decodes assets on a background thread, textures are uploaded on the render thread
+//Jobs run in submission order, so a job may rely on the ones queued before it
+class AsyncAssetLoader
+{
+public:
+	//Initializes variables, the worker starts on the first submit
+	AsyncAssetLoader();
+
+	//Stops and joins the worker, unfinished surfaces are freed
+	~AsyncAssetLoader();
+
+	//Queues a job, decode runs on the worker and may return NULL
+	//upload runs on the render thread in pump, the surface is freed right after it
+	void submit(std::function<SDL_Surface*()> decode, std::function<void(SDL_Surface*)> upload);
+
+	//Runs uploads of finished jobs, returns how many ran
+	int pump();
+
+	//Checks if every job has been decoded and uploaded
+	bool isIdle();
+
+	//Gets the event type pushed whenever a job finishes decoding
+	Uint32 getEventType();
+
+	//Stops the worker
+	void stop();
+
+private:
+	//A queued or finished job
+	struct AssetJob
+	{
+		std::function<SDL_Surface*()> decode;
+		std::function<void(SDL_Surface*)> upload;
+		SDL_Surface* surface;
+	};
+
+	//Worker thread body
+	void workerLoop();
+
+	std::thread mWorker;
+	bool mStarted;
+	bool mStopping;
+
+	//Jobs to decode and decoded jobs waiting for upload
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::deque<AssetJob> mPending;
+	std::deque<AssetJob> mCompleted;
+
+	//Jobs not yet uploaded
+	int mOutstanding;
+
+	//Wakes a main loop sleeping in SDL_WaitEvent
+	Uint32 mEventType;
+};
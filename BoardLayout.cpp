@@ -0,0 +1,163 @@
+#include <SDL.h>
+#include "BoardLayout.h"
+
+BoardLayout::BoardLayout()
+{
+	//initialize
+	mColumns = 3;
+	mRows = 3;
+	mHudHeight = 0;
+	mOutputWidth = 0;
+	mOutputHeight = 0;
+	mScaleX = 1.0f;
+	mScaleY = 1.0f;
+	mBoardRect.x = mBoardRect.y = mBoardRect.w = mBoardRect.h = 0;
+	mHudRect = mBoardRect;
+}
+
+void BoardLayout::setGrid(int columns, int rows)
+{
+	mColumns = SDL_max(1, SDL_min(columns, MAX_GRID_SIZE));
+	mRows = SDL_max(1, SDL_min(rows, MAX_GRID_SIZE));
+}
+
+bool BoardLayout::parseGrid(const char* text, int* columns, int* rows)
+{
+	int parsedColumns = 0;
+	int parsedRows = 0;
+	char end = 0;
+	if (SDL_sscanf(text, "%dx%d%c", &parsedColumns, &parsedRows, &end) != 2 ||
+		parsedColumns < 1 || parsedColumns > MAX_GRID_SIZE || parsedRows < 1 || parsedRows > MAX_GRID_SIZE)
+	{
+		return false;
+	}
+	*columns = parsedColumns;
+	*rows = parsedRows;
+	return true;
+}
+
+void BoardLayout::setHudHeight(int hudHeight)
+{
+	mHudHeight = hudHeight;
+}
+
+void BoardLayout::update(SDL_Window* gWindow, SDL_Renderer* gRenderer)
+{
+	//Window size is in points, output size in pixels
+	SDL_GetRendererOutputSize(gRenderer, &mOutputWidth, &mOutputHeight);
+	int windowWidth = mOutputWidth;
+	int windowHeight = mOutputHeight;
+
+	//Offscreen renderers have no window, points are pixels
+	if (gWindow != NULL)
+	{
+		SDL_GetWindowSize(gWindow, &windowWidth, &windowHeight);
+	}
+
+	mScaleX = windowWidth > 0 ? (float)mOutputWidth / windowWidth : 1.0f;
+	mScaleY = windowHeight > 0 ? (float)mOutputHeight / windowHeight : 1.0f;
+	placeRects();
+}
+
+void BoardLayout::resize(int windowWidth, int windowHeight)
+{
+	mOutputWidth = (int)(windowWidth * mScaleX + 0.5f);
+	mOutputHeight = (int)(windowHeight * mScaleY + 0.5f);
+	placeRects();
+}
+
+void BoardLayout::setScale(float scaleX, float scaleY)
+{
+	mScaleX = scaleX;
+	mScaleY = scaleY;
+}
+
+void BoardLayout::placeRects()
+{
+	//HUD strip along the bottom, board takes the rest
+	int hudPixels = (int)(mHudHeight * mScaleY + 0.5f);
+	if (hudPixels > mOutputHeight)
+	{
+		hudPixels = mOutputHeight;
+	}
+	mBoardRect.x = 0;
+	mBoardRect.y = 0;
+	mBoardRect.w = mOutputWidth;
+	mBoardRect.h = mOutputHeight - hudPixels;
+
+	mHudRect.x = 0;
+	mHudRect.y = mBoardRect.h;
+	mHudRect.w = mOutputWidth;
+	mHudRect.h = hudPixels;
+}
+
+bool BoardLayout::handleEvent(SDL_Event* e, SDL_Window* gWindow, SDL_Renderer* gRenderer)
+{
+	if (e->type == SDL_WINDOWEVENT && e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+	{
+		update(gWindow, gRenderer);
+		return true;
+	}
+	return false;
+}
+
+void BoardLayout::toPixels(int* x, int* y)
+{
+	*x = (int)(*x * mScaleX);
+	*y = (int)(*y * mScaleY);
+}
+
+//Gets layout rects
+SDL_Rect BoardLayout::getBoardRect()
+{
+	return mBoardRect;
+}
+SDL_Rect BoardLayout::getHudRect()
+{
+	return mHudRect;
+}
+SDL_Rect BoardLayout::getCellRect(int cell)
+{
+	//Cells share edges exactly so the board has no gaps at any size
+	int column = cell % mColumns;
+	int row = cell / mColumns;
+	int x1 = mBoardRect.x + mBoardRect.w * column / mColumns;
+	int x2 = mBoardRect.x + mBoardRect.w * (column + 1) / mColumns;
+	int y1 = mBoardRect.y + mBoardRect.h * row / mRows;
+	int y2 = mBoardRect.y + mBoardRect.h * (row + 1) / mRows;
+	SDL_Rect rect = { x1, y1, x2 - x1, y2 - y1 };
+	return rect;
+}
+
+//Gets grid and output dimensions
+int BoardLayout::getColumns()
+{
+	return mColumns;
+}
+int BoardLayout::getRows()
+{
+	return mRows;
+}
+
+int BoardLayout::getCellCount()
+{
+	return mColumns * mRows;
+}
+int BoardLayout::getOutputWidth()
+{
+	return mOutputWidth;
+}
+int BoardLayout::getOutputHeight()
+{
+	return mOutputHeight;
+}
+
+//Gets pixels per window point
+float BoardLayout::getScaleX()
+{
+	return mScaleX;
+}
+float BoardLayout::getScaleY()
+{
+	return mScaleY;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+
+//Largest board in either direction
+const int MAX_GRID_SIZE = 64;
+
+//Screen layout shared by rendering and hit testing
+//Only recomputed when the window size changes, all rects are in renderer pixels
+class BoardLayout
+{
+public:
+	//Initializes variables
+	BoardLayout();
+
+	//Sets board size in cells, clamped to 1 to MAX_GRID_SIZE, and HUD strip height in window points
+	void setGrid(int columns, int rows);
+	void setHudHeight(int hudHeight);
+
+	//Recomputes layout from the window and renderer output sizes, window may be NULL offscreen
+	void update(SDL_Window* gWindow, SDL_Renderer* gRenderer);
+
+	//Recomputes layout on resize, returns true if it changed
+	bool handleEvent(SDL_Event* e, SDL_Window* gWindow, SDL_Renderer* gRenderer);
+
+	//Recomputes layout from a window size in points and the last known pixels per point
+	//For threads that may not touch the renderer
+	void resize(int windowWidth, int windowHeight);
+
+	//Sets pixels per window point, as measured where the renderer lives
+	void setScale(float scaleX, float scaleY);
+
+	//Converts window point coordinates, as in mouse events, to renderer pixels
+	void toPixels(int* x, int* y);
+
+	//Gets layout rects
+	SDL_Rect getBoardRect();
+	SDL_Rect getHudRect();
+	SDL_Rect getCellRect(int cell);
+
+	//Reads a grid size like "8x6", returns false if it is malformed or out of range
+	static bool parseGrid(const char* text, int* columns, int* rows);
+
+	//Gets grid and output dimensions
+	int getColumns();
+	int getRows();
+	int getCellCount();
+	int getOutputWidth();
+	int getOutputHeight();
+
+	//Gets pixels per window point, above 1 on high-DPI displays
+	float getScaleX();
+	float getScaleY();
+
+private:
+	//Places board and HUD in the output size
+	void placeRects();
+
+	//Grid size
+	int mColumns;
+	int mRows;
+
+	//HUD height in window points
+	int mHudHeight;
+
+	//Renderer output size
+	int mOutputWidth;
+	int mOutputHeight;
+
+	//Pixels per window point
+	float mScaleX;
+	float mScaleY;
+
+	//Computed areas
+	SDL_Rect mBoardRect;
+	SDL_Rect mHudRect;
+};
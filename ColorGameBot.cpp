@@ -0,0 +1,167 @@
+#include <SDL.h>
+#include <vector>
+#include <string.h>
+#include <math.h>
+#include "ColorGameBot.h"
+
+//Simulated time a bot takes per click
+const Uint64 BOT_CLICK_MICROS = 500000;
+
+BotStats::BotStats()
+{
+	games = 0;
+	rounds = 0;
+	wins = 0;
+	for (int i = 0; i <= MAX_LEVEL; i++)
+	{
+		levelAttempts[i] = 0;
+		levelClears[i] = 0;
+		levelDecrease[i] = 0;
+		levelDeltaE[i] = 0.0f;
+	}
+}
+
+void BotStats::merge(const BotStats& other)
+{
+	games += other.games;
+	rounds += other.rounds;
+	wins += other.wins;
+	for (int i = 0; i <= MAX_LEVEL; i++)
+	{
+		levelAttempts[i] += other.levelAttempts[i];
+		levelClears[i] += other.levelClears[i];
+		if (other.levelAttempts[i] > 0)
+		{
+			levelDecrease[i] = other.levelDecrease[i];
+			levelDeltaE[i] = other.levelDeltaE[i];
+		}
+	}
+}
+
+ColorGameBot::ColorGameBot(Uint64 seed, float noise)
+	: mRandom(seed)
+{
+	mNoise = noise > 0.0f ? noise : 0.0f;
+	mDeficiency = VISION_NORMAL;
+}
+
+void ColorGameBot::setDeficiency(ColorDeficiency deficiency)
+{
+	mDeficiency = deficiency;
+}
+
+int ColorGameBot::chooseCell(ColorGameEngine& engine)
+{
+	int cellCount = engine.getCellCount();
+	if (cellCount <= 0)
+	{
+		return -1;
+	}
+
+	//What the bot perceives in each cell
+	if ((int)mPerceived.size() < cellCount * 3)
+	{
+		mPerceived.resize(cellCount * 3);
+	}
+	float* perceived = &mPerceived[0];
+	if (mNoise > 0.0f)
+	{
+		fillNoise(perceived, cellCount * 3);
+	}
+	else
+	{
+		memset(perceived, 0, cellCount * 3 * sizeof(float));
+	}
+
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < cellCount; i++)
+	{
+		SDL_Color color = simulateDeficiency(engine.getCellColor(i), mDeficiency);
+		float channels[3] = { (float)color.r, (float)color.g, (float)color.b };
+		for (int c = 0; c < 3; c++)
+		{
+			perceived[i * 3 + c] += channels[c];
+			mean[c] += perceived[i * 3 + c];
+		}
+	}
+	for (int c = 0; c < 3; c++)
+	{
+		mean[c] /= cellCount;
+	}
+
+	//All cells but one share a color, so the odd one is farthest from the mean
+	int best = 0;
+	float bestDistance = -1.0f;
+	for (int i = 0; i < cellCount; i++)
+	{
+		float distance = 0.0f;
+		for (int c = 0; c < 3; c++)
+		{
+			float delta = perceived[i * 3 + c] - mean[c];
+			distance += delta * delta;
+		}
+		if (distance > bestDistance)
+		{
+			bestDistance = distance;
+			best = i;
+		}
+	}
+	return best;
+}
+
+void ColorGameBot::fillNoise(float* out, int count)
+{
+	//Each word gives a pair of offsets
+	int wordCount = (count + 1) / 2;
+	if ((int)mNoiseWords.size() < wordCount)
+	{
+		mNoiseWords.resize(wordCount);
+	}
+	mRandom.fill(&mNoiseWords[0], wordCount);
+
+	//Box-Muller, the radius uses (0, 1] so the log stays finite
+	for (int i = 0; i < wordCount; i++)
+	{
+		Uint64 word = mNoiseWords[i];
+		float radius = mNoise * sqrtf(-2.0f * logf(((word >> 40) + 1) * (1.0f / 16777216.0f)));
+		float angle = (float)((word >> 8) & 0xFFFFFF) * (6.28318531f / 16777216.0f);
+		out[i * 2] = radius * cosf(angle);
+		if (i * 2 + 1 < count)
+		{
+			out[i * 2 + 1] = radius * sinf(angle);
+		}
+	}
+}
+
+void ColorGameBot::playGame(ColorGameEngine& engine, BotStats& stats)
+{
+	Uint64 micros = 0;
+	engine.reset(micros);
+	stats.games++;
+
+	while (true)
+	{
+		int level = engine.getLevel();
+		stats.levelAttempts[level]++;
+		stats.levelDecrease[level] = engine.getDecreaseAmount();
+		stats.levelDeltaE[level] = engine.getDeltaE();
+		stats.rounds++;
+
+		micros += BOT_CLICK_MICROS;
+		ClickResult result = engine.applyClick(chooseCell(engine), micros);
+		if (result == CLICK_CORRECT)
+		{
+			stats.levelClears[level]++;
+		}
+		else if (result == CLICK_VICTORY)
+		{
+			stats.levelClears[level]++;
+			stats.wins++;
+			return;
+		}
+		else
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include "ColorGameEngine.h"
+#include "GameRng.h"
+#include "ColorVision.h"
+
+//Results of bot games, per level counts give the difficulty curve
+struct BotStats
+{
+	//Initializes counters
+	BotStats();
+
+	//Adds another set of results
+	void merge(const BotStats& other);
+
+	long long games;
+	long long rounds;
+	long long wins;
+
+	//Rounds reached and rounds cleared at each level
+	long long levelAttempts[MAX_LEVEL + 1];
+	long long levelClears[MAX_LEVEL + 1];
+
+	//Decrease amount and perceptual difference the board used at each level
+	int levelDecrease[MAX_LEVEL + 1];
+	float levelDeltaE[MAX_LEVEL + 1];
+};
+
+//Automated player that finds the odd cell by comparing RGB values
+class ColorGameBot
+{
+public:
+	//Initializes bot, noise is the standard deviation added to each perceived channel
+	ColorGameBot(Uint64 seed, float noise = 0.0f);
+
+	//Makes the bot see colors as with a color vision deficiency
+	void setDeficiency(ColorDeficiency deficiency);
+
+	//Picks the cell that looks most different from the rest
+	int chooseCell(ColorGameEngine& engine);
+
+	//Plays one game to the end as fast as possible, adding results to stats
+	void playGame(ColorGameEngine& engine, BotStats& stats);
+
+private:
+	//Fills out with count normally distributed offsets for the perceived channels
+	void fillNoise(float* out, int count);
+
+	//Perceptual noise model, random words for a whole board are generated at once
+	GameRngBatch mRandom;
+	std::vector<Uint64> mNoiseWords;
+	float mNoise;
+
+	//Simulated color vision
+	ColorDeficiency mDeficiency;
+
+	//What the bot perceives in each cell, only grows when the board does
+	std::vector<float> mPerceived;
+};
@@ -0,0 +1,206 @@
+#include <SDL.h>
+#include "ColorGameEngine.h"
+#include "ColorScience.h"
+
+//Moves the largest channel by amount, darker unless that would go below zero
+static SDL_Color oddColorFor(SDL_Color base, int amount)
+{
+	Uint8* channel = &base.b;
+	if (base.r >= base.g && base.r >= base.b)
+		channel = &base.r;
+	else if (base.g >= base.r && base.g >= base.b)
+		channel = &base.g;
+	int moved = *channel >= amount ? *channel - amount : *channel + amount;
+	*channel = (Uint8)SDL_min(moved, 255);
+	return base;
+}
+
+ColorGameEngine::ColorGameEngine(int cellCount, Uint64 seed)
+	: mOwnRng(seed)
+{
+	mCellCount = cellCount;
+	mRng = &mOwnRng;
+	mTable = NULL;
+	mRound = 0;
+	reset(0);
+}
+
+void ColorGameEngine::setCellCount(int cellCount)
+{
+	mCellCount = cellCount;
+}
+
+void ColorGameEngine::setRng(GameRng* rng)
+{
+	mRng = rng != NULL ? rng : &mOwnRng;
+}
+
+GameRng* ColorGameEngine::getRng()
+{
+	return mRng;
+}
+
+void ColorGameEngine::setDifficultyTable(const DifficultyTable* table)
+{
+	mTable = table;
+}
+
+void ColorGameEngine::reset(Uint64 micros)
+{
+	//First round is always the same easy board
+	mR = 0;
+	mG = 255;
+	mB = 255;
+	mA = 255;
+	mSelected = 0;
+	mDecreaseAmount = 128;
+	mOddColor = oddColorFor(getBaseColor(), mDecreaseAmount);
+	mDeltaE = deltaE2000(srgbToLab(getBaseColor()), srgbToLab(mOddColor));
+
+	mScore = 0;
+	mLevel = 0;
+	mWinMicros = 0;
+	mRound++;
+
+	mStartMicros = micros;
+	mNowMicros = micros;
+	mRoundStartMicros = micros;
+	mReactions.reset();
+}
+
+void ColorGameEngine::step(Uint64 micros)
+{
+	mNowMicros = micros;
+}
+
+void ColorGameEngine::newRound()
+{
+	//One draw covers all four channels
+	Uint64 bits = mRng->next();
+	mA = (Uint8)(bits >> 24);
+	int pairs = mTable != NULL ? mTable->getPairCount(mLevel) : 0;
+	if (pairs > 0)
+	{
+		//Pair was picked for this level's target difference when the table was built
+		const ColorPair& pair = mTable->getPair(mLevel, mRng->nextBelow(pairs));
+		mR = pair.base.r;
+		mG = pair.base.g;
+		mB = pair.base.b;
+		mOddColor = pair.odd;
+		mOddColor.a = mA;
+		mDecreaseAmount = SDL_abs((pair.base.r - pair.odd.r) + (pair.base.g - pair.odd.g) + (pair.base.b - pair.odd.b));
+		mDeltaE = pair.deltaE;
+	}
+	else
+	{
+		mR = (Uint8)bits;
+		mG = (Uint8)(bits >> 8);
+		mB = (Uint8)(bits >> 16);
+		mDecreaseAmount = DIFFICULTY - mLevel + 1; // + mRng->nextBelow(16)
+		mOddColor = oddColorFor(getBaseColor(), mDecreaseAmount);
+		mDeltaE = deltaE2000(srgbToLab(getBaseColor()), srgbToLab(mOddColor));
+	}
+	mSelected = mRng->nextBelow(mCellCount);
+	mRound++;
+
+	//Reaction time counts from when this round appeared
+	mRoundStartMicros = mNowMicros;
+}
+
+ClickResult ColorGameEngine::applyClick(int cell, Uint64 micros)
+{
+	mNowMicros = micros;
+	if (cell < 0 || cell >= mCellCount)
+	{
+		return CLICK_IGNORED;
+	}
+	mReactions.add(getRoundMicros());
+	if (cell != mSelected)
+	{
+		return CLICK_WRONG;
+	}
+
+	mScore++;
+	if (!(mLevel >= MAX_LEVEL))
+	{
+		mLevel++;
+		newRound();
+		return CLICK_CORRECT;
+	}
+
+	//You win at level MAX_LEVEL
+	mWinMicros = getElapsedMicros();
+	newRound();
+	return CLICK_VICTORY;
+}
+
+SDL_Color ColorGameEngine::getBaseColor()
+{
+	SDL_Color color = { mR, mG, mB, mA };
+	return color;
+}
+
+SDL_Color ColorGameEngine::getOddColor()
+{
+	return mOddColor;
+}
+
+int ColorGameEngine::getOddCell()
+{
+	return mSelected;
+}
+
+int ColorGameEngine::getDecreaseAmount()
+{
+	return mDecreaseAmount;
+}
+
+float ColorGameEngine::getDeltaE()
+{
+	return mDeltaE;
+}
+
+SDL_Color ColorGameEngine::getCellColor(int cell)
+{
+	return cell == mSelected ? getOddColor() : getBaseColor();
+}
+
+//Gets progress
+int ColorGameEngine::getScore()
+{
+	return mScore;
+}
+int ColorGameEngine::getLevel()
+{
+	return mLevel;
+}
+int ColorGameEngine::getRound()
+{
+	return mRound;
+}
+int ColorGameEngine::getCellCount()
+{
+	return mCellCount;
+}
+
+//Gets game clock
+int ColorGameEngine::getElapsedSeconds()
+{
+	return (int)(getElapsedMicros() / 1000000);
+}
+Uint64 ColorGameEngine::getElapsedMicros()
+{
+	return mNowMicros - mStartMicros;
+}
+Uint64 ColorGameEngine::getRoundMicros()
+{
+	return mNowMicros - mRoundStartMicros;
+}
+double ColorGameEngine::getWinTime()
+{
+	return mWinMicros / 1000000.0;
+}
+ReactionStats& ColorGameEngine::getReactionStats()
+{
+	return mReactions;
+}
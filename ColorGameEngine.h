@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SDL.h>
+#include "GameRng.h"
+#include "DifficultyTable.h"
+#include "ReactionStats.h"
+
+//Game rules
+const int DIFFICULTY = 32; //1 = hardest 
+const int MAX_LEVEL = 30;
+
+//Outcome of a click on the board
+enum ClickResult
+{
+	CLICK_IGNORED = 0,	//not a cell
+	CLICK_CORRECT = 1,	//found the odd cell, next round started
+	CLICK_WRONG = 2,	//game over
+	CLICK_VICTORY = 3	//found the odd cell on the last level
+};
+
+//Color game rules and state, independent of any window or renderer
+class ColorGameEngine
+{
+public:
+	//Initializes a game on a board with the given number of cells, rounds come from its own generator
+	ColorGameEngine(int cellCount = 9, Uint64 seed = 0);
+
+	//Draws rounds from a shared generator instead, NULL goes back to the engine's own
+	void setRng(GameRng* rng);
+
+	//Gets generator rounds are drawn from, seed it to replay a session
+	GameRng* getRng();
+
+	//Picks rounds from perceptual color pairs, NULL or an empty level uses the DIFFICULTY rule
+	void setDifficultyTable(const DifficultyTable* table);
+
+	//Sets number of cells, takes effect from the next round
+	void setCellCount(int cellCount);
+
+	//Starts over from the first round, game clock starts at the given microseconds
+	void reset(Uint64 micros);
+
+	//Advances the game clock
+	void step(Uint64 micros);
+
+	//Applies a click on a cell at the given time in microseconds
+	ClickResult applyClick(int cell, Uint64 micros);
+
+	//Gets colors of the current round
+	SDL_Color getBaseColor();
+	SDL_Color getOddColor();
+	int getOddCell();
+	int getDecreaseAmount();
+
+	//Gets CIEDE2000 difference of the round's colors
+	float getDeltaE();
+
+	//Gets color shown in a cell
+	SDL_Color getCellColor(int cell);
+
+	//Gets progress
+	int getScore();
+	int getLevel();
+	int getRound();
+	int getCellCount();
+
+	//Gets whole seconds since the game clock started, for the HUD
+	int getElapsedSeconds();
+
+	//Gets microseconds since the game clock started, and since the current round appeared
+	Uint64 getElapsedMicros();
+	Uint64 getRoundMicros();
+
+	//Gets seconds from start to the winning click, 0 until won
+	double getWinTime();
+
+	//Gets reaction times of every click on a cell this game
+	ReactionStats& getReactionStats();
+
+private:
+	//Rolls colors and odd cell of a new round at the current level
+	void newRound();
+
+	//Number of cells on the board
+	int mCellCount;
+
+	//Round generator, mOwnRng unless one was injected
+	GameRng mOwnRng;
+	GameRng* mRng;
+
+	//color components
+	Uint8 mR;
+	Uint8 mG;
+	Uint8 mB;
+	Uint8 mA;
+
+	//odd cell color
+	SDL_Color mOddColor;
+
+	//the selected box and how different it is
+	int mSelected;
+	int mDecreaseAmount;
+	float mDeltaE;
+
+	//Perceptual color pairs, NULL for the DIFFICULTY rule
+	const DifficultyTable* mTable;
+
+	//game variables
+	int mScore;
+	int mLevel;
+	Uint64 mWinMicros;
+
+	//Rounds started since reset, lets renderers notice a new board
+	int mRound;
+
+	//game clock in microseconds, and when the current round appeared
+	Uint64 mStartMicros;
+	Uint64 mNowMicros;
+	Uint64 mRoundStartMicros;
+
+	//Reaction times of this game
+	ReactionStats mReactions;
+};
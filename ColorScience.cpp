@@ -0,0 +1,329 @@
+#include <SDL.h>
+#include <math.h>
+#include "ColorScience.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLOR_SCIENCE_SSE2
+#endif
+
+//D65 reference white
+const float WHITE_X = 0.95047f;
+const float WHITE_Y = 1.0f;
+const float WHITE_Z = 1.08883f;
+
+const float PI = 3.14159265358979f;
+const float DEGREES = 180.0f / PI;
+const float RADIANS = PI / 180.0f;
+
+//25^7, the chroma weighting constant of CIEDE2000
+const float POW25_7 = 6103515625.0f;
+
+//sRGB decoding of every 8-bit value
+struct LinearTable
+{
+	float values[256];
+
+	LinearTable()
+	{
+		for (int i = 0; i < 256; i++)
+		{
+			float c = i / 255.0f;
+			values[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+		}
+	}
+};
+
+//Built on first use, function statics are thread safe to initialize
+static const float* linearTable()
+{
+	static const LinearTable table;
+	return table.values;
+}
+
+float srgbToLinear(Uint8 channel)
+{
+	return linearTable()[channel];
+}
+
+Uint8 linearToSrgb(float linear)
+{
+	if (linear <= 0.0f)
+		return 0;
+	if (linear >= 1.0f)
+		return 255;
+	float c = linear <= 0.0031308f ? linear * 12.92f : 1.055f * powf(linear, 1.0f / 2.4f) - 0.055f;
+	return (Uint8)(c * 255.0f + 0.5f);
+}
+
+//Lab companding
+static float labF(float t)
+{
+	return t > 0.008856452f ? cbrtf(t) : t * 7.787037f + 16.0f / 116.0f;
+}
+
+LabColor srgbToLab(SDL_Color color)
+{
+	float r = srgbToLinear(color.r);
+	float g = srgbToLinear(color.g);
+	float b = srgbToLinear(color.b);
+
+	float x = labF((0.4124564f * r + 0.3575761f * g + 0.1804375f * b) / WHITE_X);
+	float y = labF((0.2126729f * r + 0.7151522f * g + 0.0721750f * b) / WHITE_Y);
+	float z = labF((0.0193339f * r + 0.1191920f * g + 0.9503041f * b) / WHITE_Z);
+
+	LabColor lab = { 116.0f * y - 16.0f, 500.0f * (x - y), 200.0f * (y - z) };
+	return lab;
+}
+
+float deltaE2000(LabColor first, LabColor second)
+{
+	LabBatch a = { &first.L, &first.a, &first.b };
+	LabBatch b = { &second.L, &second.a, &second.b };
+	float result;
+	deltaE2000Batch(a, b, &result, 1);
+	return result;
+}
+
+#ifdef COLOR_SCIENCE_SSE2
+//Picks a where mask is set, b elsewhere
+static inline __m128 selectPs(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+//Angle of (x, y) in degrees, matching atan2f including signed zeros
+static inline __m128 atan2Degrees(__m128 y, __m128 x)
+{
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+	__m128 ax = _mm_andnot_ps(signBit, x);
+	__m128 ay = _mm_andnot_ps(signBit, y);
+
+	//Reduce to atan of [0, 1], then below tan(pi/8) for the polynomial
+	__m128 steep = _mm_cmpgt_ps(ay, ax);
+	__m128 high = _mm_max_ps(ax, ay);
+	__m128 t = _mm_div_ps(_mm_min_ps(ax, ay), selectPs(_mm_cmpeq_ps(high, _mm_setzero_ps()), _mm_set1_ps(1.0f), high));
+	__m128 large = _mm_cmpgt_ps(t, _mm_set1_ps(0.41421356f));
+	t = selectPs(large, _mm_div_ps(_mm_sub_ps(t, _mm_set1_ps(1.0f)), _mm_add_ps(t, _mm_set1_ps(1.0f))), t);
+
+	//Cephes atanf polynomial
+	__m128 z = _mm_mul_ps(t, t);
+	__m128 p = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(8.05374449538e-2f), z), _mm_set1_ps(1.38776856032e-1f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.99777106478e-1f));
+	p = _mm_sub_ps(_mm_mul_ps(p, z), _mm_set1_ps(3.33329491539e-1f));
+	__m128 angle = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), t), t);
+	angle = _mm_add_ps(angle, _mm_and_ps(large, _mm_set1_ps(PI / 4.0f)));
+
+	//Back out to the full circle
+	angle = selectPs(steep, _mm_sub_ps(_mm_set1_ps(PI / 2.0f), angle), angle);
+	__m128 negativeX = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+	angle = selectPs(negativeX, _mm_sub_ps(_mm_set1_ps(PI), angle), angle);
+	angle = _mm_or_ps(angle, _mm_and_ps(signBit, y));
+	return _mm_mul_ps(angle, _mm_set1_ps(DEGREES));
+}
+
+//Sine and cosine of an angle in degrees, reduced by quarter turns which are exact in degrees
+static inline void sinCosDegrees(__m128 degrees, __m128* sine, __m128* cosine)
+{
+	__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(degrees, _mm_set1_ps(1.0f / 90.0f)));
+	__m128 x = _mm_mul_ps(_mm_sub_ps(degrees, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90.0f))), _mm_set1_ps(RADIANS));
+
+	//Cephes sinf and cosf polynomials on [-pi/4, pi/4]
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 s = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(-8.3321608736e-3f));
+	s = _mm_sub_ps(_mm_mul_ps(s, z), _mm_set1_ps(1.6666654611e-1f));
+	s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+	__m128 c = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(1.388731625493765e-3f));
+	c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+	c = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_set1_ps(1.0f));
+
+	//Odd quadrants swap sine and cosine, the upper two negate sine, the middle two cosine
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+	__m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	*sine = _mm_xor_ps(selectPs(swap, c, s), sineSign);
+	*cosine = _mm_xor_ps(selectPs(swap, s, c), cosineSign);
+}
+
+//Cosine of an angle in degrees
+static inline __m128 cosDegrees(__m128 degrees)
+{
+	__m128 sine, cosine;
+	sinCosDegrees(degrees, &sine, &cosine);
+	return cosine;
+}
+
+//e^x, x is clamped to where the result stays a normal float
+static inline __m128 expPs(__m128 x)
+{
+	x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-87.0f)), _mm_set1_ps(88.0f));
+
+	//Split off a power of two, the rest is within ln(2) / 2 of zero
+	__m128i n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.44269504089f)));
+	__m128 nf = _mm_cvtepi32_ps(n);
+	x = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(nf, _mm_set1_ps(0.693359375f))), _mm_mul_ps(nf, _mm_set1_ps(-2.12194440e-4f)));
+
+	//Cephes expf polynomial
+	__m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.9875691500e-4f), x), _mm_set1_ps(1.3981999507e-3f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(8.3334519073e-3f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(4.1665795894e-2f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(1.6666665459e-1f));
+	p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(5.0000001201e-1f));
+	p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, x), x), x), _mm_set1_ps(1.0f));
+
+	__m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+	return _mm_mul_ps(p, scale);
+}
+
+//25^7 weighting of a mean chroma, c^7 / (c^7 + 25^7) under a square root
+static inline __m128 chromaWeight(__m128 c)
+{
+	__m128 c7 = _mm_mul_ps(_mm_mul_ps(c, c), c);
+	c7 = _mm_mul_ps(_mm_mul_ps(c7, c7), c);
+	return _mm_sqrt_ps(_mm_div_ps(c7, _mm_add_ps(c7, _mm_set1_ps(POW25_7))));
+}
+
+//Same steps as the scalar loop below, 4 pairs at a time
+static void deltaE2000Sse2(const LabBatch& first, const LabBatch& second, float* out, int count)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 deg180 = _mm_set1_ps(180.0f);
+	const __m128 deg360 = _mm_set1_ps(360.0f);
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+	for (int i = 0; i + 4 <= count; i += 4)
+	{
+		__m128 L1 = _mm_loadu_ps(first.L + i), a1 = _mm_loadu_ps(first.a + i), b1 = _mm_loadu_ps(first.b + i);
+		__m128 L2 = _mm_loadu_ps(second.L + i), a2 = _mm_loadu_ps(second.a + i), b2 = _mm_loadu_ps(second.b + i);
+
+		//Chroma adjusted a*
+		__m128 meanC = _mm_mul_ps(_mm_add_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a1, a1), _mm_mul_ps(b1, b1))),
+			_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a2, a2), _mm_mul_ps(b2, b2)))), half);
+		__m128 g = _mm_mul_ps(half, _mm_sub_ps(one, chromaWeight(meanC)));
+		__m128 a1p = _mm_mul_ps(_mm_add_ps(one, g), a1);
+		__m128 a2p = _mm_mul_ps(_mm_add_ps(one, g), a2);
+		__m128 c1p = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a1p, a1p), _mm_mul_ps(b1, b1)));
+		__m128 c2p = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a2p, a2p), _mm_mul_ps(b2, b2)));
+
+		//Hue angles in degrees, 0 for achromatic colors
+		__m128 h1p = atan2Degrees(b1, a1p);
+		__m128 h2p = atan2Degrees(b2, a2p);
+		h1p = _mm_add_ps(h1p, _mm_and_ps(_mm_cmplt_ps(h1p, zero), deg360));
+		h2p = _mm_add_ps(h2p, _mm_and_ps(_mm_cmplt_ps(h2p, zero), deg360));
+		__m128 chromaProduct = _mm_mul_ps(c1p, c2p);
+		__m128 chromatic = _mm_cmpneq_ps(chromaProduct, zero);
+
+		//Differences
+		__m128 dLp = _mm_sub_ps(L2, L1);
+		__m128 dCp = _mm_sub_ps(c2p, c1p);
+		__m128 dh = _mm_sub_ps(h2p, h1p);
+		dh = _mm_sub_ps(dh, _mm_and_ps(_mm_cmpgt_ps(dh, deg180), deg360));
+		dh = _mm_add_ps(dh, _mm_and_ps(_mm_cmplt_ps(dh, _mm_sub_ps(zero, deg180)), deg360));
+		dh = _mm_and_ps(chromatic, dh);
+		__m128 halfSine, halfCosine;
+		sinCosDegrees(_mm_mul_ps(dh, half), &halfSine, &halfCosine);
+		__m128 dHp = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), _mm_sqrt_ps(chromaProduct)), halfSine);
+
+		//Means
+		__m128 meanL = _mm_mul_ps(_mm_add_ps(L1, L2), half);
+		__m128 meanCp = _mm_mul_ps(_mm_add_ps(c1p, c2p), half);
+		__m128 hueSum = _mm_add_ps(h1p, h2p);
+		__m128 near = _mm_cmple_ps(_mm_andnot_ps(signBit, _mm_sub_ps(h1p, h2p)), deg180);
+		__m128 wrapped = selectPs(_mm_cmplt_ps(hueSum, deg360), _mm_add_ps(hueSum, deg360), _mm_sub_ps(hueSum, deg360));
+		__m128 meanH = selectPs(near, _mm_mul_ps(hueSum, half), _mm_mul_ps(wrapped, half));
+		meanH = selectPs(chromatic, meanH, hueSum);
+
+		//Weighting functions
+		__m128 t = _mm_sub_ps(one, _mm_mul_ps(_mm_set1_ps(0.17f), cosDegrees(_mm_sub_ps(meanH, _mm_set1_ps(30.0f)))));
+		t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(0.24f), cosDegrees(_mm_mul_ps(_mm_set1_ps(2.0f), meanH))));
+		t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(0.32f), cosDegrees(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(3.0f), meanH), _mm_set1_ps(6.0f)))));
+		t = _mm_sub_ps(t, _mm_mul_ps(_mm_set1_ps(0.20f), cosDegrees(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(4.0f), meanH), _mm_set1_ps(63.0f)))));
+		__m128 hueOffset = _mm_div_ps(_mm_sub_ps(meanH, _mm_set1_ps(275.0f)), _mm_set1_ps(25.0f));
+		__m128 dTheta = _mm_mul_ps(_mm_set1_ps(30.0f), expPs(_mm_sub_ps(zero, _mm_mul_ps(hueOffset, hueOffset))));
+		__m128 rc = _mm_mul_ps(_mm_set1_ps(2.0f), chromaWeight(meanCp));
+		__m128 lDelta = _mm_sub_ps(meanL, _mm_set1_ps(50.0f));
+		__m128 lOffset = _mm_mul_ps(lDelta, lDelta);
+		__m128 sl = _mm_add_ps(one, _mm_div_ps(_mm_mul_ps(_mm_set1_ps(0.015f), lOffset), _mm_sqrt_ps(_mm_add_ps(_mm_set1_ps(20.0f), lOffset))));
+		__m128 sc = _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(0.045f), meanCp));
+		__m128 sh = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.015f), meanCp), t));
+		__m128 rotationSine, rotationCosine;
+		sinCosDegrees(_mm_mul_ps(_mm_set1_ps(2.0f), dTheta), &rotationSine, &rotationCosine);
+		__m128 rt = _mm_sub_ps(zero, _mm_mul_ps(rotationSine, rc));
+
+		__m128 lightness = _mm_div_ps(dLp, sl);
+		__m128 chroma = _mm_div_ps(dCp, sc);
+		__m128 hue = _mm_div_ps(dHp, sh);
+		__m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lightness, lightness), _mm_mul_ps(chroma, chroma)), _mm_mul_ps(hue, hue));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_mul_ps(rt, chroma), hue));
+		_mm_storeu_ps(out + i, _mm_sqrt_ps(sum));
+	}
+}
+#endif
+
+void deltaE2000Batch(const LabBatch& first, const LabBatch& second, float* out, int count)
+{
+	int i = 0;
+#ifdef COLOR_SCIENCE_SSE2
+	deltaE2000Sse2(first, second, out, count);
+	i = count & ~3;
+#endif
+	//Sharma, Wu and Dalal's formulation, scalar tail or everything without SSE2
+	for (; i < count; i++)
+	{
+		float L1 = first.L[i], a1 = first.a[i], b1 = first.b[i];
+		float L2 = second.L[i], a2 = second.a[i], b2 = second.b[i];
+
+		//Chroma adjusted a*
+		float meanC = (sqrtf(a1 * a1 + b1 * b1) + sqrtf(a2 * a2 + b2 * b2)) * 0.5f;
+		float meanC7 = meanC * meanC * meanC;
+		meanC7 = meanC7 * meanC7 * meanC;
+		float g = 0.5f * (1.0f - sqrtf(meanC7 / (meanC7 + POW25_7)));
+		float a1p = (1.0f + g) * a1;
+		float a2p = (1.0f + g) * a2;
+		float c1p = sqrtf(a1p * a1p + b1 * b1);
+		float c2p = sqrtf(a2p * a2p + b2 * b2);
+
+		//Hue angles in degrees, 0 for achromatic colors
+		float h1p = atan2f(b1, a1p) * DEGREES;
+		float h2p = atan2f(b2, a2p) * DEGREES;
+		h1p = h1p < 0.0f ? h1p + 360.0f : h1p;
+		h2p = h2p < 0.0f ? h2p + 360.0f : h2p;
+		float chromaProduct = c1p * c2p;
+		bool chromatic = chromaProduct != 0.0f;
+
+		//Differences
+		float dLp = L2 - L1;
+		float dCp = c2p - c1p;
+		float dh = h2p - h1p;
+		dh = dh > 180.0f ? dh - 360.0f : (dh < -180.0f ? dh + 360.0f : dh);
+		dh = chromatic ? dh : 0.0f;
+		float dHp = 2.0f * sqrtf(chromaProduct) * sinf(dh * 0.5f * RADIANS);
+
+		//Means
+		float meanL = (L1 + L2) * 0.5f;
+		float meanCp = (c1p + c2p) * 0.5f;
+		float hueSum = h1p + h2p;
+		float meanH = fabsf(h1p - h2p) <= 180.0f ? hueSum * 0.5f : (hueSum < 360.0f ? (hueSum + 360.0f) * 0.5f : (hueSum - 360.0f) * 0.5f);
+		meanH = chromatic ? meanH : hueSum;
+
+		//Weighting functions
+		float t = 1.0f - 0.17f * cosf((meanH - 30.0f) * RADIANS) + 0.24f * cosf(2.0f * meanH * RADIANS)
+			+ 0.32f * cosf((3.0f * meanH + 6.0f) * RADIANS) - 0.20f * cosf((4.0f * meanH - 63.0f) * RADIANS);
+		float hueOffset = (meanH - 275.0f) / 25.0f;
+		float dTheta = 30.0f * expf(-hueOffset * hueOffset);
+		float meanCp7 = meanCp * meanCp * meanCp;
+		meanCp7 = meanCp7 * meanCp7 * meanCp;
+		float rc = 2.0f * sqrtf(meanCp7 / (meanCp7 + POW25_7));
+		float lOffset = (meanL - 50.0f) * (meanL - 50.0f);
+		float sl = 1.0f + 0.015f * lOffset / sqrtf(20.0f + lOffset);
+		float sc = 1.0f + 0.045f * meanCp;
+		float sh = 1.0f + 0.015f * meanCp * t;
+		float rt = -sinf(2.0f * dTheta * RADIANS) * rc;
+
+		float lightness = dLp / sl;
+		float chroma = dCp / sc;
+		float hue = dHp / sh;
+		out[i] = sqrtf(lightness * lightness + chroma * chroma + hue * hue + rt * chroma * hue);
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SDL.h>
+
+//CIE L*a*b* color, D65 white
+struct LabColor
+{
+	float L;
+	float a;
+	float b;
+};
+
+//Lab colors kept as structure of arrays, one stream per channel
+struct LabBatch
+{
+	float* L;
+	float* a;
+	float* b;
+};
+
+//Gets linear light value of an 8-bit sRGB channel, from a 256 entry table
+float srgbToLinear(Uint8 channel);
+
+//Converts linear light back to an 8-bit sRGB channel, clamped
+Uint8 linearToSrgb(float linear);
+
+//Converts an sRGB color to Lab
+LabColor srgbToLab(SDL_Color color);
+
+//Gets CIEDE2000 color difference of two Lab colors
+float deltaE2000(LabColor first, LabColor second);
+
+//Gets CIEDE2000 differences of count pairs, first[i] against second[i]
+//Runs 4 pairs at a time with SSE2 where available, meant for building the difficulty table
+void deltaE2000Batch(const LabBatch& first, const LabBatch& second, float* out, int count);
@@ -0,0 +1,191 @@
+#include <SDL.h>
+#include <string.h>
+#include "ColorVision.h"
+#include "ColorScience.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLOR_VISION_SSE2
+#endif
+
+//Linear light to sRGB through a table, indexed by linear * LINEAR_STEPS
+const int LINEAR_STEPS = 4095;
+
+//Every deficiency as two linear RGB projections split by a plane through gray
+//Vienot's single projection uses the same matrix on both sides
+struct DeficiencyModel
+{
+	float first[9];
+	float second[9];
+	float plane[3];
+};
+
+//Projections in linear sRGB, as tabulated by libDaltonLens
+static const DeficiencyModel MODELS[4] =
+{
+	//Normal
+	{ { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f },
+	  { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f },
+	  { 0.0f, 0.0f, 0.0f } },
+	//Protan, Vienot
+	{ { 0.11238f, 0.88762f, 0.0f, 0.11238f, 0.88762f, 0.0f, 0.00401f, -0.00401f, 1.0f },
+	  { 0.11238f, 0.88762f, 0.0f, 0.11238f, 0.88762f, 0.0f, 0.00401f, -0.00401f, 1.0f },
+	  { 0.0f, 0.0f, 0.0f } },
+	//Deutan, Vienot
+	{ { 0.29275f, 0.70725f, 0.0f, 0.29275f, 0.70725f, 0.0f, -0.02234f, 0.02234f, 1.0f },
+	  { 0.29275f, 0.70725f, 0.0f, 0.29275f, 0.70725f, 0.0f, -0.02234f, 0.02234f, 1.0f },
+	  { 0.0f, 0.0f, 0.0f } },
+	//Tritan, Brettel
+	{ { 1.01277f, 0.13548f, -0.14826f, -0.01243f, 0.86812f, 0.14431f, 0.07589f, 0.80500f, 0.11911f },
+	  { 0.93678f, 0.18979f, -0.12657f, 0.06154f, 0.81526f, 0.12320f, -0.37562f, 1.12767f, 0.24796f },
+	  { 0.03901f, -0.02788f, -0.01113f } }
+};
+
+//sRGB encoding of LINEAR_STEPS + 1 evenly spaced linear values
+struct EncodeTable
+{
+	Uint8 values[LINEAR_STEPS + 1];
+
+	EncodeTable()
+	{
+		for (int i = 0; i <= LINEAR_STEPS; i++)
+		{
+			values[i] = linearToSrgb((float)i / LINEAR_STEPS);
+		}
+	}
+};
+
+//Same lazy function static as srgbToLinear's table
+static const Uint8* encodeTable()
+{
+	static const EncodeTable table;
+	return table.values;
+}
+
+//Gets table index of a linear value, clamped
+static inline int linearIndex(float linear)
+{
+	int index = (int)(linear * LINEAR_STEPS + 0.5f);
+	return index < 0 ? 0 : (index > LINEAR_STEPS ? LINEAR_STEPS : index);
+}
+
+ColorDeficiency parseColorDeficiency(const char* name)
+{
+	if (strcmp(name, "protan") == 0)
+		return VISION_PROTAN;
+	if (strcmp(name, "deutan") == 0)
+		return VISION_DEUTAN;
+	if (strcmp(name, "tritan") == 0)
+		return VISION_TRITAN;
+	return VISION_NORMAL;
+}
+
+SDL_Color simulateDeficiency(SDL_Color color, ColorDeficiency deficiency)
+{
+	if (deficiency == VISION_NORMAL)
+	{
+		return color;
+	}
+
+	const DeficiencyModel& model = MODELS[deficiency];
+	float rgb[3] = { srgbToLinear(color.r), srgbToLinear(color.g), srgbToLinear(color.b) };
+	const float* m = rgb[0] * model.plane[0] + rgb[1] * model.plane[1] + rgb[2] * model.plane[2] >= 0.0f ? model.first : model.second;
+
+	const Uint8* encode = encodeTable();
+	SDL_Color result;
+	result.r = encode[linearIndex(m[0] * rgb[0] + m[1] * rgb[1] + m[2] * rgb[2])];
+	result.g = encode[linearIndex(m[3] * rgb[0] + m[4] * rgb[1] + m[5] * rgb[2])];
+	result.b = encode[linearIndex(m[6] * rgb[0] + m[7] * rgb[1] + m[8] * rgb[2])];
+	result.a = color.a;
+	return result;
+}
+
+//Projects count pixels held as linear channel arrays, writes table indices back in place
+static void projectPixels(const DeficiencyModel& model, float* r, float* g, float* b, int* outR, int* outG, int* outB, int count)
+{
+	int i = 0;
+#ifdef COLOR_VISION_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 steps = _mm_set1_ps((float)LINEAR_STEPS);
+	const __m128 half = _mm_set1_ps(0.5f);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 vr = _mm_loadu_ps(r + i);
+		__m128 vg = _mm_loadu_ps(g + i);
+		__m128 vb = _mm_loadu_ps(b + i);
+
+		//Side of the separation plane picks the projection, per lane
+		__m128 side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vr, _mm_set1_ps(model.plane[0])), _mm_mul_ps(vg, _mm_set1_ps(model.plane[1]))),
+			_mm_mul_ps(vb, _mm_set1_ps(model.plane[2])));
+		__m128 useFirst = _mm_cmpge_ps(side, zero);
+
+		__m128 channels[3];
+		for (int c = 0; c < 3; c++)
+		{
+			const float* f = model.first + c * 3;
+			const float* s = model.second + c * 3;
+			__m128 first = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vr, _mm_set1_ps(f[0])), _mm_mul_ps(vg, _mm_set1_ps(f[1]))), _mm_mul_ps(vb, _mm_set1_ps(f[2])));
+			__m128 second = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vr, _mm_set1_ps(s[0])), _mm_mul_ps(vg, _mm_set1_ps(s[1]))), _mm_mul_ps(vb, _mm_set1_ps(s[2])));
+			__m128 value = _mm_or_ps(_mm_and_ps(useFirst, first), _mm_andnot_ps(useFirst, second));
+
+			//Clamp to the encode table
+			channels[c] = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(value, steps), half), zero), _mm_add_ps(steps, half));
+		}
+		_mm_storeu_si128((__m128i*)(outR + i), _mm_cvttps_epi32(channels[0]));
+		_mm_storeu_si128((__m128i*)(outG + i), _mm_cvttps_epi32(channels[1]));
+		_mm_storeu_si128((__m128i*)(outB + i), _mm_cvttps_epi32(channels[2]));
+	}
+#endif
+	//Scalar tail, or everything without SSE2
+	for (; i < count; i++)
+	{
+		const float* m = r[i] * model.plane[0] + g[i] * model.plane[1] + b[i] * model.plane[2] >= 0.0f ? model.first : model.second;
+		outR[i] = linearIndex(m[0] * r[i] + m[1] * g[i] + m[2] * b[i]);
+		outG[i] = linearIndex(m[3] * r[i] + m[4] * g[i] + m[5] * b[i]);
+		outB[i] = linearIndex(m[6] * r[i] + m[7] * g[i] + m[8] * b[i]);
+	}
+}
+
+SDL_Surface* simulateDeficiencySurface(SDL_Surface* surface, ColorDeficiency deficiency)
+{
+	//Own copy in a known layout, also for read-only sources
+	SDL_Surface* result = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+	if (result == NULL || deficiency == VISION_NORMAL)
+	{
+		return result;
+	}
+
+	const DeficiencyModel& model = MODELS[deficiency];
+	const Uint8* encode = encodeTable();
+
+	//One row at a time through channel arrays
+	int width = result->w;
+	float* linear = new float[width * 3];
+	int* indices = new int[width * 3];
+	if (SDL_MUSTLOCK(result))
+	{
+		SDL_LockSurface(result);
+	}
+	for (int y = 0; y < result->h; y++)
+	{
+		Uint32* row = (Uint32*)((Uint8*)result->pixels + y * result->pitch);
+		for (int x = 0; x < width; x++)
+		{
+			linear[x] = srgbToLinear((Uint8)(row[x] >> 16));
+			linear[width + x] = srgbToLinear((Uint8)(row[x] >> 8));
+			linear[width * 2 + x] = srgbToLinear((Uint8)row[x]);
+		}
+		projectPixels(model, linear, linear + width, linear + width * 2, indices, indices + width, indices + width * 2, width);
+		for (int x = 0; x < width; x++)
+		{
+			row[x] = (row[x] & 0xFF000000) | ((Uint32)encode[indices[x]] << 16) | ((Uint32)encode[indices[width + x]] << 8) | encode[indices[width * 2 + x]];
+		}
+	}
+	if (SDL_MUSTLOCK(result))
+	{
+		SDL_UnlockSurface(result);
+	}
+	delete[] linear;
+	delete[] indices;
+	return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL.h>
+
+//Color vision deficiencies that can be simulated
+enum ColorDeficiency
+{
+	VISION_NORMAL = 0,
+	VISION_PROTAN = 1,	//no long wavelength cones
+	VISION_DEUTAN = 2,	//no medium wavelength cones
+	VISION_TRITAN = 3	//no short wavelength cones
+};
+
+//Gets deficiency from its name, "protan", "deutan" or "tritan", VISION_NORMAL otherwise
+ColorDeficiency parseColorDeficiency(const char* name);
+
+//Gets how a color looks with a deficiency
+//Protan and deutan use Vienot, Brettel and Mollon 1999, tritan uses Brettel, Vienot and Mollon 1997
+SDL_Color simulateDeficiency(SDL_Color color, ColorDeficiency deficiency);
+
+//Gets an ARGB8888 copy of a surface as seen with a deficiency, NULL on failure
+//The source is left untouched, it may be read-only mapped data
+//Runs 4 pixels at a time with SSE2 where available, meant for load time rather than per frame
+SDL_Surface* simulateDeficiencySurface(SDL_Surface* surface, ColorDeficiency deficiency);
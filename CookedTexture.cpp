@@ -0,0 +1,146 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "CookedTexture.h"
+
+std::string cookedTexturePath(const std::string& imagePath)
+{
+	size_t dot = imagePath.find_last_of('.');
+	size_t slash = imagePath.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+	{
+		return imagePath + ".cgtx";
+	}
+	return imagePath.substr(0, dot) + ".cgtx";
+}
+
+//Checks header fields against the number of pixel bytes available
+static bool checkCookedHeader(const CookedTextureHeader& header, Uint64 pixelBytes)
+{
+	//Only plain packed formats, rows must fit the stored pitch
+	Uint32 bytesPerPixel = SDL_BYTESPERPIXEL(header.format);
+	return memcmp(header.magic, COOKED_TEXTURE_MAGIC, 4) == 0 && header.version == COOKED_TEXTURE_VERSION &&
+		header.width > 0 && header.height > 0 && bytesPerPixel > 0 &&
+		header.pitch / bytesPerPixel >= header.width &&
+		(Uint64)header.pitch * header.height <= pixelBytes;
+}
+
+bool parseCookedTexture(const void* data, size_t size, CookedTextureHeader* header, const void** pixels)
+{
+	if (data == NULL || size < sizeof(CookedTextureHeader))
+	{
+		return false;
+	}
+	memcpy(header, data, sizeof(CookedTextureHeader));
+	if (!checkCookedHeader(*header, size - sizeof(CookedTextureHeader)))
+	{
+		return false;
+	}
+	*pixels = (const Uint8*)data + sizeof(CookedTextureHeader);
+	return true;
+}
+
+SDL_Surface* cookedTextureSurface(const void* data, size_t size)
+{
+	CookedTextureHeader header;
+	const void* pixels;
+	if (!parseCookedTexture(data, size, &header, &pixels))
+	{
+		return NULL;
+	}
+
+	//Surface never writes to its pixels, so the const data can be shared
+	return SDL_CreateRGBSurfaceWithFormatFrom((void*)pixels, header.width, header.height, SDL_BITSPERPIXEL(header.format), header.pitch, header.format);
+}
+
+SDL_Surface* loadCookedTexture(const std::string& path)
+{
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		return NULL;
+	}
+
+	//Read the header, then the pixels straight into the surface
+	SDL_Surface* surface = NULL;
+	CookedTextureHeader header;
+	Sint64 fileSize = SDL_RWsize(file);
+	if (fileSize >= (Sint64)sizeof(header) && SDL_RWread(file, &header, sizeof(header), 1) == 1 &&
+		checkCookedHeader(header, (Uint64)(fileSize - sizeof(header))))
+	{
+		surface = SDL_CreateRGBSurfaceWithFormat(0, header.width, header.height, SDL_BITSPERPIXEL(header.format), header.format);
+		if (surface != NULL && surface->pitch == (int)header.pitch)
+		{
+			if (SDL_RWread(file, surface->pixels, header.pitch, header.height) != header.height)
+			{
+				SDL_FreeSurface(surface);
+				surface = NULL;
+			}
+		}
+		else if (surface != NULL)
+		{
+			//Surface rows are padded differently, read row by row
+			for (Uint32 y = 0; y < header.height && surface != NULL; y++)
+			{
+				if (SDL_RWread(file, (Uint8*)surface->pixels + y * surface->pitch, header.pitch, 1) != 1)
+				{
+					SDL_FreeSurface(surface);
+					surface = NULL;
+				}
+			}
+		}
+	}
+	else
+	{
+		printf("Invalid cooked texture %s\n", path.c_str());
+	}
+	SDL_RWclose(file);
+	return surface;
+}
+
+bool cookTexture(SDL_Surface* surface, Uint32 format, const std::string& path)
+{
+	//Convert once here so loading never has to
+	SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+	if (converted == NULL)
+	{
+		printf("Unable to convert surface! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	FILE* output = fopen(path.c_str(), "wb");
+	if (output == NULL)
+	{
+		printf("Unable to write %s\n", path.c_str());
+		SDL_FreeSurface(converted);
+		return false;
+	}
+
+	//Rows are stored tightly packed
+	CookedTextureHeader header;
+	memcpy(header.magic, COOKED_TEXTURE_MAGIC, 4);
+	header.version = COOKED_TEXTURE_VERSION;
+	header.width = converted->w;
+	header.height = converted->h;
+	header.format = format;
+	header.pitch = converted->w * SDL_BYTESPERPIXEL(format);
+	fwrite(&header, sizeof(header), 1, output);
+	if (SDL_MUSTLOCK(converted))
+	{
+		SDL_LockSurface(converted);
+	}
+	for (int y = 0; y < converted->h; y++)
+	{
+		fwrite((Uint8*)converted->pixels + y * converted->pitch, 1, header.pitch, output);
+	}
+	if (SDL_MUSTLOCK(converted))
+	{
+		SDL_UnlockSurface(converted);
+	}
+
+	bool success = ferror(output) == 0;
+	fclose(output);
+	SDL_FreeSurface(converted);
+	return success;
+}
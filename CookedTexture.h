@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+
+//Cooked texture layout, all fields little endian
+//Header, then height rows of pitch bytes in the stored pixel format
+const char COOKED_TEXTURE_MAGIC[4] = { 'C', 'G', 'T', 'X' };
+const Uint32 COOKED_TEXTURE_VERSION = 1;
+
+struct CookedTextureHeader
+{
+	char magic[4];
+	Uint32 version;
+	Uint32 width;
+	Uint32 height;
+
+	//SDL_PixelFormatEnum of the pixels
+	Uint32 format;
+	Uint32 pitch;
+};
+
+//Gets cooked file path for an image, "img/a.png" becomes "img/a.cgtx"
+std::string cookedTexturePath(const std::string& imagePath);
+
+//Checks a cooked file in memory, returns false if it is invalid or truncated
+bool parseCookedTexture(const void* data, size_t size, CookedTextureHeader* header, const void** pixels);
+
+//Wraps cooked pixels in a surface without copying, data must outlive the surface
+SDL_Surface* cookedTextureSurface(const void* data, size_t size);
+
+//Reads a cooked file into a new surface, NULL if missing or invalid
+SDL_Surface* loadCookedTexture(const std::string& path);
+
+//Converts a surface to the given pixel format and writes it as a cooked file
+bool cookTexture(SDL_Surface* surface, Uint32 format, const std::string& path);
@@ -0,0 +1,149 @@
+#include <SDL.h>
+#include <math.h>
+#include <vector>
+#include "DifficultyTable.h"
+#include "ColorScience.h"
+#include "GameRng.h"
+#include "ColorVision.h"
+
+DifficultyTable::DifficultyTable()
+{
+	mOffsets.push_back(0);
+}
+
+float DifficultyTable::getTargetDeltaE(int level, int levels)
+{
+	//Even steps on a log scale, each level is the same fraction harder than the last
+	if (levels <= 2)
+	{
+		return DELTA_E_EASIEST;
+	}
+	float t = (float)(level - 1) / (levels - 2);
+	return DELTA_E_EASIEST * powf(DELTA_E_HARDEST / DELTA_E_EASIEST, t);
+}
+
+void DifficultyTable::build(int levels, ColorDeficiency deficiency, PairPolicy policy, Uint64 seed, int baseColors)
+{
+	std::vector< std::vector<ColorPair> > buckets(levels > 0 ? levels : 0);
+	float logRange = logf(DELTA_E_HARDEST / DELTA_E_EASIEST);
+
+	//Candidate odd colors of one base, as the game always made them: one channel moved
+	//Confusion pairs run along other channels too, so every channel is tried for them
+	bool confusing = deficiency != VISION_NORMAL && policy == PAIRS_CONFUSING;
+	const int MAX_CANDIDATES = 3 * 255;
+	std::vector<float> lab(MAX_CANDIDATES * 9);
+	std::vector<float> deltaE(MAX_CANDIDATES);
+	std::vector<float> seenDeltaE(MAX_CANDIDATES);
+	std::vector<SDL_Color> candidates(MAX_CANDIDATES);
+	LabBatch candidateLab = { &lab[0], &lab[MAX_CANDIDATES], &lab[MAX_CANDIDATES * 2] };
+	LabBatch baseLab = { &lab[MAX_CANDIDATES * 3], &lab[MAX_CANDIDATES * 4], &lab[MAX_CANDIDATES * 5] };
+	LabBatch seenLab = { &lab[MAX_CANDIDATES * 6], &lab[MAX_CANDIDATES * 7], &lab[MAX_CANDIDATES * 8] };
+
+	GameRng rng(seed);
+	for (int i = 0; i < baseColors && levels > 1; i++)
+	{
+		Uint64 bits = rng.next();
+		SDL_Color base = { (Uint8)bits, (Uint8)(bits >> 8), (Uint8)(bits >> 16), 255 };
+
+		//Move the largest channel, darker while it can go darker, lighter otherwise
+		int largest = 2;
+		if (base.r >= base.g && base.r >= base.b)
+			largest = 0;
+		else if (base.g >= base.r && base.g >= base.b)
+			largest = 1;
+		int count = 0;
+		for (int offset = 0; offset < 3; offset++)
+		{
+			if (offset != largest && !confusing)
+				continue;
+			int value = (&base.r)[offset];
+			for (int step = 1; step < 256; step++)
+			{
+				int moved = value >= step ? value - step : value + step;
+				if (moved > 255)
+					break;
+				SDL_Color odd = base;
+				(&odd.r)[offset] = (Uint8)moved;
+				candidates[count++] = odd;
+			}
+		}
+
+		//Differences as a normal viewer and as the deficient viewer see them
+		LabColor baseColor = srgbToLab(base);
+		LabColor seenBase = srgbToLab(simulateDeficiency(base, deficiency));
+		for (int c = 0; c < count; c++)
+		{
+			LabColor odd = srgbToLab(candidates[c]);
+			candidateLab.L[c] = odd.L;
+			candidateLab.a[c] = odd.a;
+			candidateLab.b[c] = odd.b;
+			baseLab.L[c] = baseColor.L;
+			baseLab.a[c] = baseColor.a;
+			baseLab.b[c] = baseColor.b;
+		}
+		deltaE2000Batch(baseLab, candidateLab, &deltaE[0], count);
+		if (deficiency != VISION_NORMAL)
+		{
+			for (int c = 0; c < count; c++)
+			{
+				LabColor odd = srgbToLab(simulateDeficiency(candidates[c], deficiency));
+				candidateLab.L[c] = odd.L;
+				candidateLab.a[c] = odd.a;
+				candidateLab.b[c] = odd.b;
+				seenLab.L[c] = seenBase.L;
+				seenLab.a[c] = seenBase.a;
+				seenLab.b[c] = seenBase.b;
+			}
+			deltaE2000Batch(seenLab, candidateLab, &seenDeltaE[0], count);
+		}
+		else
+		{
+			seenDeltaE = deltaE;
+		}
+
+		//Nearest level straight from the log curve, kept if close enough to its target
+		for (int c = 0; c < count; c++)
+		{
+			float judged = confusing ? deltaE[c] : seenDeltaE[c];
+			if (judged <= 0.0f || (confusing && seenDeltaE[c] >= DELTA_E_HARDEST))
+				continue;
+			int level = 1 + (int)floorf(logf(judged / DELTA_E_EASIEST) / logRange * (levels - 2) + 0.5f);
+			if (level < 1 || level >= levels)
+				continue;
+			float target = getTargetDeltaE(level, levels);
+			if (fabsf(judged / target - 1.0f) <= DELTA_E_TOLERANCE)
+			{
+				ColorPair pair = { base, candidates[c], judged };
+				buckets[level].push_back(pair);
+			}
+		}
+	}
+
+	//Flatten into one array
+	mPairs.clear();
+	mOffsets.assign(1, 0);
+	for (int level = 0; level < levels; level++)
+	{
+		mPairs.insert(mPairs.end(), buckets[level].begin(), buckets[level].end());
+		mOffsets.push_back((int)mPairs.size());
+	}
+}
+
+int DifficultyTable::getPairCount(int level) const
+{
+	if (level < 0 || level + 1 >= (int)mOffsets.size())
+	{
+		return 0;
+	}
+	return mOffsets[level + 1] - mOffsets[level];
+}
+
+const ColorPair& DifficultyTable::getPair(int level, int index) const
+{
+	return mPairs[mOffsets[level] + index];
+}
+
+int DifficultyTable::getLevelCount() const
+{
+	return (int)mOffsets.size() - 1;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include "ColorVision.h"
+
+//Perceptual difficulty curve, CIEDE2000 difference between base and odd color
+const float DELTA_E_EASIEST = 20.0f;	//first level after the intro board
+const float DELTA_E_HARDEST = 1.0f;		//last level, about one just noticeable difference
+const float DELTA_E_TOLERANCE = 0.05f;	//accepted relative error around a level's target
+
+//Random base colors tried when building a table
+const int DIFFICULTY_BASE_COLORS = 2048;
+
+//How pairs are chosen for a color vision deficiency
+enum PairPolicy
+{
+	PAIRS_VISIBLE = 0,	//level targets apply to what the deficient viewer sees
+	PAIRS_CONFUSING = 1	//level targets apply to normal vision, the deficient viewer sees less than DELTA_E_HARDEST
+};
+
+//A board's two colors and how far apart they look
+struct ColorPair
+{
+	SDL_Color base;
+	SDL_Color odd;
+	float deltaE;
+};
+
+//Color pairs for every level, each within tolerance of the level's target difference
+//Built once up front so picking a round is a single lookup, read-only afterwards and safe to share between threads
+class DifficultyTable
+{
+public:
+	//Initializes an empty table
+	DifficultyTable();
+
+	//Builds pairs for levels 1 to levels - 1, level 0 keeps the fixed intro board
+	//With a deficiency, pairs are judged by the policy, levels without any pairs are left empty
+	void build(int levels, ColorDeficiency deficiency = VISION_NORMAL, PairPolicy policy = PAIRS_VISIBLE, Uint64 seed = 1, int baseColors = DIFFICULTY_BASE_COLORS);
+
+	//Gets target difference of a level
+	static float getTargetDeltaE(int level, int levels);
+
+	//Gets pairs available for a level
+	int getPairCount(int level) const;
+	const ColorPair& getPair(int level, int index) const;
+
+	//Gets number of levels built
+	int getLevelCount() const;
+
+private:
+	//Pairs of every level back to back, level i spans mOffsets[i] to mOffsets[i + 1]
+	std::vector<ColorPair> mPairs;
+	std::vector<int> mOffsets;
+};
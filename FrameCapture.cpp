@@ -0,0 +1,276 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "FrameCapture.h"
+
+//Multipliers for the four hash lanes and the final mix
+const Uint64 HASH_PRIME_1 = 0x9E3779B185EBCA87ULL;
+const Uint64 HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+const Uint64 HASH_PRIME_3 = 0x165667B19E3779F9ULL;
+
+FrameCapture::FrameCapture()
+{
+	//initialize
+	mSurface = NULL;
+	mFormat = CAPTURE_HASH_ONLY;
+	mEnabled = false;
+	mHashFile = NULL;
+	mFrameCount = 0;
+	mLastHash = 0;
+	mHasGolden = false;
+	mMismatches = 0;
+}
+
+FrameCapture::~FrameCapture()
+{
+	//Deallocates memory, calls close
+	close();
+}
+
+void FrameCapture::enable(std::string directory, CaptureFormat format)
+{
+	mEnabled = true;
+	mDirectory = directory;
+	mFormat = directory.empty() ? CAPTURE_HASH_ONLY : format;
+}
+
+bool FrameCapture::isEnabled()
+{
+	return mEnabled;
+}
+
+bool FrameCapture::loadGolden(std::string path)
+{
+	FILE* file = fopen(path.c_str(), "r");
+	if (file == NULL)
+	{
+		printf("Unable to open golden hashes %s\n", path.c_str());
+		return false;
+	}
+
+	//One "frame state hash" line per frame, # starts a comment
+	mGolden.clear();
+	char line[256];
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		int frame, state;
+		unsigned long long hash;
+		if (line[0] != '#' && sscanf(line, "%d %d %llx", &frame, &state, &hash) == 3)
+		{
+			mGolden.push_back((Uint64)hash);
+		}
+	}
+	fclose(file);
+
+	mEnabled = true;
+	mHasGolden = true;
+	return true;
+}
+
+SDL_Renderer* FrameCapture::createRenderer(int width, int height)
+{
+	//Fixed format so hashes and raw dumps are the same on every machine
+	mSurface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+	if (mSurface == NULL)
+	{
+		printf("Capture surface could not be created! SDL Error: %s\n", SDL_GetError());
+		return NULL;
+	}
+
+	if (!mDirectory.empty())
+	{
+		std::string hashPath = mDirectory + "/" + CAPTURE_HASH_FILE;
+		mHashFile = fopen(hashPath.c_str(), "w");
+		if (mHashFile == NULL)
+		{
+			printf("Unable to write %s\n", hashPath.c_str());
+		}
+		else
+		{
+			fprintf(mHashFile, "# %dx%d ARGB8888, frame state hash\n", width, height);
+		}
+	}
+
+	SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(mSurface);
+	if (renderer == NULL)
+	{
+		printf("Software renderer could not be created! SDL Error: %s\n", SDL_GetError());
+	}
+	return renderer;
+}
+
+void FrameCapture::capture(int state)
+{
+	if (mSurface == NULL)
+	{
+		return;
+	}
+
+	//A frame that did not change is not a new frame
+	Uint64 hash = hashPixels(mSurface);
+	if (mFrameCount > 0 && hash == mLastHash)
+	{
+		return;
+	}
+	mLastHash = hash;
+	int index = mFrameCount++;
+
+	if (mHashFile != NULL)
+	{
+		fprintf(mHashFile, "%d %d %016llx\n", index, state, (unsigned long long)hash);
+	}
+	if (mFormat != CAPTURE_HASH_ONLY)
+	{
+		writeFrame(index);
+	}
+
+	if (mHasGolden)
+	{
+		bool missing = index >= (int)mGolden.size();
+		if (missing || mGolden[index] != hash)
+		{
+			if (mMismatches < CAPTURE_MAX_REPORTS)
+			{
+				if (missing)
+				{
+					printf("Frame %d (state %d): %016llx, not in golden hashes\n", index, state, (unsigned long long)hash);
+				}
+				else
+				{
+					printf("Frame %d (state %d): %016llx, expected %016llx\n", index, state, (unsigned long long)hash, (unsigned long long)mGolden[index]);
+				}
+			}
+			mMismatches++;
+		}
+	}
+}
+
+bool FrameCapture::writeFrame(int index)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "/frame_%06d.%s", index, mFormat == CAPTURE_PNG ? "png" : "raw");
+	std::string path = mDirectory + name;
+
+	if (mFormat == CAPTURE_PNG)
+	{
+		if (IMG_SavePNG(mSurface, path.c_str()) != 0)
+		{
+			printf("Unable to write %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+			return false;
+		}
+		return true;
+	}
+
+	//Raw frames go straight from the surface, one write when rows are not padded
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file == NULL)
+	{
+		printf("Unable to write %s\n", path.c_str());
+		return false;
+	}
+	const Uint8* pixels = (const Uint8*)mSurface->pixels;
+	size_t rowBytes = (size_t)mSurface->w * 4;
+	if ((size_t)mSurface->pitch == rowBytes)
+	{
+		fwrite(pixels, rowBytes * mSurface->h, 1, file);
+	}
+	else
+	{
+		for (int y = 0; y < mSurface->h; y++)
+		{
+			fwrite(pixels + (size_t)y * mSurface->pitch, rowBytes, 1, file);
+		}
+	}
+	fclose(file);
+	return true;
+}
+
+void FrameCapture::close()
+{
+	if (mHashFile != NULL)
+	{
+		fclose(mHashFile);
+		mHashFile = NULL;
+	}
+	if (mSurface != NULL)
+	{
+		SDL_FreeSurface(mSurface);
+		mSurface = NULL;
+	}
+}
+
+int FrameCapture::getFrameCount()
+{
+	return mFrameCount;
+}
+
+int FrameCapture::getMismatchCount()
+{
+	return mMismatches;
+}
+
+bool FrameCapture::report()
+{
+	if (!mEnabled)
+	{
+		return true;
+	}
+
+	//Frames the golden run had but this one never drew count as misses too
+	int missing = mHasGolden && (int)mGolden.size() > mFrameCount ? (int)mGolden.size() - mFrameCount : 0;
+	printf("Captured %d frames", mFrameCount);
+	if (mHasGolden)
+	{
+		printf(", %d differ from golden, %d golden frames not drawn", mMismatches, missing);
+	}
+	printf("\n");
+	return mMismatches == 0 && missing == 0;
+}
+
+Uint64 FrameCapture::hashPixels(SDL_Surface* surface)
+{
+	//Four independent lanes over 8 byte words keep the multipliers busy
+	Uint64 lanes[4] = { HASH_PRIME_1, HASH_PRIME_2, HASH_PRIME_3, 0 };
+	Uint64 tail = 0;
+	size_t rowBytes = (size_t)surface->w * surface->format->BytesPerPixel;
+	size_t words = rowBytes / 8;
+	const Uint8* row = (const Uint8*)surface->pixels;
+	for (int y = 0; y < surface->h; y++, row += surface->pitch)
+	{
+		size_t i = 0;
+		for (; i + 4 <= words; i += 4)
+		{
+			for (int lane = 0; lane < 4; lane++)
+			{
+				Uint64 word;
+				memcpy(&word, row + (i + lane) * 8, 8);
+				lanes[lane] = (lanes[lane] ^ word) * HASH_PRIME_1;
+				lanes[lane] ^= lanes[lane] >> 29;
+			}
+		}
+		for (; i < words; i++)
+		{
+			Uint64 word;
+			memcpy(&word, row + i * 8, 8);
+			tail = (tail ^ word) * HASH_PRIME_2;
+		}
+		for (size_t j = words * 8; j < rowBytes; j++)
+		{
+			tail = (tail ^ row[j]) * HASH_PRIME_3;
+		}
+	}
+
+	//Fold lanes and size together
+	Uint64 hash = (Uint64)surface->w << 32 | (Uint32)surface->h;
+	for (int lane = 0; lane < 4; lane++)
+	{
+		hash = (hash ^ lanes[lane]) * HASH_PRIME_2;
+		hash ^= hash >> 31;
+	}
+	hash = (hash ^ tail) * HASH_PRIME_3;
+	hash ^= hash >> 32;
+	return hash;
+}
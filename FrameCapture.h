@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//How captured frames are written
+enum CaptureFormat
+{
+	CAPTURE_HASH_ONLY = 0,	//only hash and compare, nothing written per frame
+	CAPTURE_RAW = 1,		//surface rows as they are in memory, ARGB8888
+	CAPTURE_PNG = 2			//PNG written straight from the surface
+};
+
+//Hash list written next to captured frames and read back as golden hashes
+const char* const CAPTURE_HASH_FILE = "frames.txt";
+
+//Golden mismatches printed before going quiet
+const int CAPTURE_MAX_REPORTS = 10;
+
+//Offscreen render target for headless frame capture
+//The game draws through a software renderer into a surface, each new frame is
+//hashed straight from the surface pixels, optionally dumped, and compared to golden hashes
+class FrameCapture
+{
+public:
+	//Initializes variables
+	FrameCapture();
+
+	//Closes files and frees the surface
+	~FrameCapture();
+
+	//Turns capture on, directory may be NULL to only hash frames
+	void enable(std::string directory, CaptureFormat format);
+	bool isEnabled();
+
+	//Compares every captured frame against a hash list written by an earlier capture
+	bool loadGolden(std::string path);
+
+	//Creates the target surface and a software renderer drawing into it
+	//The renderer belongs to the caller and must be destroyed before close
+	SDL_Renderer* createRenderer(int width, int height);
+
+	//Takes the frame last presented on the target, frames identical to the previous one are skipped
+	void capture(int state);
+
+	//Finishes the hash list and frees the surface
+	void close();
+
+	//Gets frames kept and how many differed from the golden hashes
+	int getFrameCount();
+	int getMismatchCount();
+
+	//Prints how the capture went, returns false if any frame missed its golden hash
+	bool report();
+
+	//Hashes visible pixels only, row padding is ignored
+	static Uint64 hashPixels(SDL_Surface* surface);
+
+private:
+	//Writes the target surface as frame number index
+	bool writeFrame(int index);
+
+	//Target and output
+	SDL_Surface* mSurface;
+	std::string mDirectory;
+	CaptureFormat mFormat;
+	bool mEnabled;
+	FILE* mHashFile;
+
+	//Frames kept so far and the hash of the last one
+	int mFrameCount;
+	Uint64 mLastHash;
+
+	//Expected hashes in frame order
+	std::vector<Uint64> mGolden;
+	bool mHasGolden;
+	int mMismatches;
+};
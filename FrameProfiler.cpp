@@ -0,0 +1,280 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <math.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "FrameProfiler.h"
+
+//Section names for the overlay and trace
+const char* PROFILE_SECTION_NAMES[PROFILE_SECTION_TOTAL] = { "Frame", "Events", "Board", "HUD", "Present", "State", "Click" };
+
+//Overlay refresh interval
+const Uint32 PROFILE_OVERLAY_TICKS = 500;
+
+//Ring of the calling thread and the profiler it belongs to
+thread_local ProfileRing* tRing = NULL;
+thread_local FrameProfiler* tRingOwner = NULL;
+
+FrameProfiler::FrameProfiler()
+{
+	//initialize
+	mEnabled = true;
+	mOverlayVisible = false;
+	mOverlayFont = NULL;
+	mOverlayTicks = 0;
+	resetHistograms();
+}
+
+FrameProfiler::~FrameProfiler()
+{
+	free();
+	for (int i = 0; i < (int)mRings.size(); i++)
+	{
+		delete mRings[i];
+	}
+}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+	mEnabled = enabled;
+}
+
+bool FrameProfiler::isEnabled()
+{
+	return mEnabled;
+}
+
+ProfileRing* FrameProfiler::getThreadRing()
+{
+	if (tRingOwner != this)
+	{
+		//First sample of this thread, the only time a lock is taken
+		std::lock_guard<std::mutex> lock(mRingsMutex);
+		ProfileRing* ring = new ProfileRing();
+		ring->head = 0;
+		ring->consumed = 0;
+		ring->threadIndex = (int)mRings.size();
+		mRings.push_back(ring);
+		tRing = ring;
+		tRingOwner = this;
+	}
+	return tRing;
+}
+
+void FrameProfiler::record(int section, Uint64 start, Uint64 end)
+{
+	if (!mEnabled)
+	{
+		return;
+	}
+
+	//Write the slot, then publish it
+	ProfileRing* ring = getThreadRing();
+	unsigned int head = ring->head.load(std::memory_order_relaxed);
+	ProfileSample* sample = &ring->samples[head & (PROFILE_RING_SIZE - 1)];
+	sample->start = start;
+	sample->end = end;
+	sample->section = section;
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+bool FrameProfiler::readSample(ProfileRing* ring, unsigned int index, ProfileSample* sample)
+{
+	*sample = ring->samples[index & (PROFILE_RING_SIZE - 1)];
+
+	//The slot is reused once the writer reaches index plus a ring, it may already be writing it
+	std::atomic_thread_fence(std::memory_order_acquire);
+	unsigned int head = ring->head.load(std::memory_order_relaxed);
+	return head - index < (unsigned int)PROFILE_RING_SIZE;
+}
+
+void FrameProfiler::update()
+{
+	double ticksToMicroseconds = 1000000.0 / SDL_GetPerformanceFrequency();
+
+	std::lock_guard<std::mutex> lock(mRingsMutex);
+	for (int r = 0; r < (int)mRings.size(); r++)
+	{
+		ProfileRing* ring = mRings[r];
+		unsigned int head = ring->head.load(std::memory_order_acquire);
+
+		//Samples older than one ring were overwritten
+		unsigned int first = ring->consumed;
+		if (head - first > (unsigned int)PROFILE_RING_SIZE)
+		{
+			first = head - PROFILE_RING_SIZE;
+		}
+
+		for (unsigned int i = first; i != head; i++)
+		{
+			ProfileSample sample;
+			if (!readSample(ring, i, &sample))
+				continue;
+			double microseconds = (sample.end - sample.start) * ticksToMicroseconds;
+			int bucket = (int)(log2(microseconds + 1.0) * 4.0);
+			if (bucket >= PROFILE_BUCKETS)
+				bucket = PROFILE_BUCKETS - 1;
+			if (sample.section >= 0 && sample.section < PROFILE_SECTION_TOTAL)
+			{
+				mHistograms[sample.section][bucket]++;
+				mHistogramCounts[sample.section]++;
+			}
+		}
+		ring->consumed = head;
+	}
+}
+
+double FrameProfiler::getPercentile(int section, double fraction)
+{
+	unsigned int count = mHistogramCounts[section];
+	if (count == 0)
+	{
+		return 0.0;
+	}
+
+	//Walk buckets until the fraction is covered, report the bucket's upper edge
+	unsigned int target = (unsigned int)ceil(count * fraction);
+	unsigned int seen = 0;
+	for (int bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+	{
+		seen += mHistograms[section][bucket];
+		if (seen >= target)
+		{
+			return (pow(2.0, (bucket + 1) / 4.0) - 1.0) / 1000.0;
+		}
+	}
+	return (pow(2.0, PROFILE_BUCKETS / 4.0) - 1.0) / 1000.0;
+}
+
+void FrameProfiler::resetHistograms()
+{
+	for (int section = 0; section < PROFILE_SECTION_TOTAL; section++)
+	{
+		for (int bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+		{
+			mHistograms[section][bucket] = 0;
+		}
+		mHistogramCounts[section] = 0;
+	}
+}
+
+bool FrameProfiler::exportChromeTrace(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL)
+	{
+		printf("Unable to write trace %s\n", path);
+		return false;
+	}
+
+	double ticksToMicroseconds = 1000000.0 / SDL_GetPerformanceFrequency();
+	bool first = true;
+	fprintf(file, "{\"traceEvents\":[\n");
+
+	std::lock_guard<std::mutex> lock(mRingsMutex);
+	for (int r = 0; r < (int)mRings.size(); r++)
+	{
+		ProfileRing* ring = mRings[r];
+		unsigned int head = ring->head.load(std::memory_order_acquire);
+		unsigned int start = head > (unsigned int)PROFILE_RING_SIZE ? head - PROFILE_RING_SIZE : 0;
+		for (unsigned int i = start; i != head; i++)
+		{
+			ProfileSample sample;
+			if (!readSample(ring, i, &sample))
+				continue;
+			if (sample.section < 0 || sample.section >= PROFILE_SECTION_TOTAL)
+				continue;
+			fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				first ? "" : ",\n", PROFILE_SECTION_NAMES[sample.section], ring->threadIndex,
+				sample.start * ticksToMicroseconds, (sample.end - sample.start) * ticksToMicroseconds);
+			first = false;
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+	fclose(file);
+	printf("Wrote trace %s\n", path);
+	return true;
+}
+
+void FrameProfiler::toggleOverlay()
+{
+	mOverlayVisible = !mOverlayVisible;
+	mOverlayTicks = 0;
+	resetHistograms();
+}
+
+bool FrameProfiler::isOverlayVisible()
+{
+	return mOverlayVisible;
+}
+
+void FrameProfiler::setOverlayFont(TTF_Font* gFont)
+{
+	mOverlayFont = gFont;
+}
+
+bool FrameProfiler::refreshOverlay(SDL_Renderer* gRenderer)
+{
+	//Text is only re-rendered a couple of times a second
+	Uint32 now = SDL_GetTicks();
+	if (!mOverlayVisible || mOverlayFont == NULL || (mOverlayTicks != 0 && now - mOverlayTicks < PROFILE_OVERLAY_TICKS))
+	{
+		return false;
+	}
+	mOverlayTicks = now;
+
+	update();
+	SDL_Color textColor = { 255, 255, 255, 255 };
+	SDL_Color bgColor = { 0, 0, 0, 255 };
+	for (int section = 0; section < PROFILE_SECTION_TOTAL; section++)
+	{
+		char line[96];
+		snprintf(line, sizeof(line), "%-8s p50 %6.2f  p95 %6.2f  p99 %6.2f ms", PROFILE_SECTION_NAMES[section],
+			getPercentile(section, 0.50), getPercentile(section, 0.95), getPercentile(section, 0.99));
+		mOverlayLines[section].loadFromRenderedText(line, textColor, bgColor, mOverlayFont, gRenderer);
+	}
+
+	//Each refresh shows the latest window only
+	resetHistograms();
+	return true;
+}
+
+void FrameProfiler::renderOverlay(int x, int y, SDL_Renderer* gRenderer)
+{
+	if (!mOverlayVisible)
+	{
+		return;
+	}
+	for (int section = 0; section < PROFILE_SECTION_TOTAL; section++)
+	{
+		mOverlayLines[section].render(x, y, gRenderer);
+		y += mOverlayLines[section].getHeight();
+	}
+}
+
+//Deallocates overlay textures
+void FrameProfiler::free()
+{
+	for (int section = 0; section < PROFILE_SECTION_TOTAL; section++)
+	{
+		mOverlayLines[section].free();
+	}
+}
+
+ProfileScope::ProfileScope(FrameProfiler* profiler, int section)
+{
+	mProfiler = profiler;
+	mSection = section;
+	mStart = profiler != NULL ? SDL_GetPerformanceCounter() : 0;
+}
+
+ProfileScope::~ProfileScope()
+{
+	if (mProfiler != NULL)
+	{
+		mProfiler->record(mSection, mStart, SDL_GetPerformanceCounter());
+	}
+}
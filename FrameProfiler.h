@@ -0,0 +1,127 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "LTexture.h"
+
+//Parts of a frame that are timed
+enum ProfileSection
+{
+	PROFILE_FRAME = 0,
+	PROFILE_EVENTS = 1,
+	PROFILE_BOARD = 2,
+	PROFILE_HUD = 3,
+	PROFILE_PRESENT = 4,
+	PROFILE_STATE = 5,
+	PROFILE_CLICK = 6,
+	PROFILE_SECTION_TOTAL = 7
+};
+
+//Samples kept per thread, power of two
+const int PROFILE_RING_SIZE = 4096;
+
+//Histogram buckets, four per doubling of microseconds
+const int PROFILE_BUCKETS = 96;
+
+//One timed span
+struct ProfileSample
+{
+	Uint64 start;
+	Uint64 end;
+	int section;
+};
+
+//Samples of one thread, written only by that thread and read without locks
+struct ProfileRing
+{
+	ProfileSample samples[PROFILE_RING_SIZE];
+	std::atomic<unsigned int> head;
+	unsigned int consumed;
+	int threadIndex;
+};
+
+//Built-in frame profiler with percentile histograms, overlay and trace export
+class FrameProfiler
+{
+public:
+	//Initializes variables
+	FrameProfiler();
+
+	//Deallocates memory
+	~FrameProfiler();
+
+	//Turns sample recording on or off
+	void setEnabled(bool enabled);
+	bool isEnabled();
+
+	//Records a span on the calling thread's ring
+	void record(int section, Uint64 start, Uint64 end);
+
+	//Folds new samples into the histograms
+	void update();
+
+	//Gets a percentile of a section in milliseconds, 0.5 for p50
+	double getPercentile(int section, double fraction);
+
+	//Clears the histograms
+	void resetHistograms();
+
+	//Writes every retained sample as Chrome trace JSON
+	bool exportChromeTrace(const char* path);
+
+	//Shows or hides the overlay
+	void toggleOverlay();
+	bool isOverlayVisible();
+
+	//Sets font of the overlay, no overlay is drawn without one
+	void setOverlayFont(TTF_Font* gFont);
+
+	//Rebuilds overlay text if it is due, returns true if it changed
+	bool refreshOverlay(SDL_Renderer* gRenderer);
+
+	//Draws the overlay at given point
+	void renderOverlay(int x, int y, SDL_Renderer* gRenderer);
+
+	//Deallocates overlay textures
+	void free();
+
+private:
+	//Gets or creates the ring of the calling thread
+	ProfileRing* getThreadRing();
+
+	//Copies a published sample, returns false if its thread may have overwritten it during the copy
+	bool readSample(ProfileRing* ring, unsigned int index, ProfileSample* sample);
+
+	//Whether samples are recorded
+	bool mEnabled;
+
+	//All thread rings, only locked when a thread records for the first time
+	std::mutex mRingsMutex;
+	std::vector<ProfileRing*> mRings;
+
+	//Counts per duration bucket for each section
+	unsigned int mHistograms[PROFILE_SECTION_TOTAL][PROFILE_BUCKETS];
+	unsigned int mHistogramCounts[PROFILE_SECTION_TOTAL];
+
+	//Overlay, one line per section
+	bool mOverlayVisible;
+	TTF_Font* mOverlayFont;
+	Uint32 mOverlayTicks;
+	LTexture mOverlayLines[PROFILE_SECTION_TOTAL];
+};
+
+//Times the enclosing scope, profiler may be NULL
+class ProfileScope
+{
+public:
+	ProfileScope(FrameProfiler* profiler, int section);
+	~ProfileScope();
+
+private:
+	FrameProfiler* mProfiler;
+	int mSection;
+	Uint64 mStart;
+};
@@ -0,0 +1,186 @@
+#include <SDL.h>
+#include "FrameScheduler.h"
+#include "InputLog.h"
+
+//Longest a real time replay sleeps at once, keeps the window responsive
+const Uint32 REPLAY_MAX_WAIT = 100;
+
+FrameScheduler::FrameScheduler()
+{
+	//initialize
+	mMode = FRAME_VSYNC;
+	mFrameMicros = 1000000 / 60;
+	mNextFrame = 0;
+	mWaited = false;
+	mRedraw = true;
+	mInput = NULL;
+	mDrawEnabled = true;
+}
+
+void FrameScheduler::setMode(FrameMode mode, int targetFps)
+{
+	mMode = mode;
+	if (targetFps > 0)
+	{
+		mFrameMicros = 1000000 / targetFps;
+	}
+	mNextFrame = mClock.getMicroseconds();
+	mWaited = false;
+
+	//A new mode always starts with a fresh frame
+	mRedraw = true;
+}
+
+FrameMode FrameScheduler::getMode()
+{
+	return mMode;
+}
+
+bool FrameScheduler::pollEvent(SDL_Event* e)
+{
+	if (mInput != NULL && mInput->getMode() == INPUT_REPLAY)
+	{
+		return pollReplayEvent(e);
+	}
+
+	bool gotEvent = false;
+
+	if (mMode == FRAME_EVENT_DRIVEN)
+	{
+		//Sleep until something happens, unless a redraw is already pending
+		if (!mWaited && !mRedraw)
+		{
+			gotEvent = SDL_WaitEvent(e) != 0;
+		}
+		else
+		{
+			gotEvent = SDL_PollEvent(e) != 0;
+		}
+		mWaited = true;
+
+		//Any event may change what is on screen
+		if (gotEvent)
+		{
+			mRedraw = true;
+		}
+	}
+	else if (mMode == FRAME_FIXED_FPS)
+	{
+		//Handle events as they arrive, but only until the next frame is due
+		Uint32 wait = getTicksUntilFrame();
+		if (wait > 0)
+		{
+			gotEvent = SDL_WaitEventTimeout(e, wait) != 0;
+		}
+		else
+		{
+			gotEvent = SDL_PollEvent(e) != 0;
+		}
+	}
+	else
+	{
+		//Present blocks on vsync, so just drain the queue
+		gotEvent = SDL_PollEvent(e) != 0;
+	}
+
+	//Frame's event phase is over
+	if (!gotEvent)
+	{
+		mWaited = false;
+	}
+	else if (mInput != NULL)
+	{
+		mInput->recordEvent(e);
+	}
+	return gotEvent;
+}
+
+bool FrameScheduler::pollReplayEvent(SDL_Event* e)
+{
+	//Closing the window still ends the replay
+	SDL_Event real;
+	while (SDL_PollEvent(&real))
+	{
+		if (real.type == SDL_QUIT)
+		{
+			*e = real;
+			mRedraw = true;
+			return true;
+		}
+	}
+
+	bool gotEvent = mInput->nextEvent(e);
+	if (!gotEvent && !mWaited && !mInput->isFastReplay() && !mInput->isReplayFinished())
+	{
+		//Real time replays sleep until the next event, or the next frame when one is due sooner
+		Uint32 wait = mInput->getTicksUntilNext();
+		if (mMode == FRAME_FIXED_FPS)
+		{
+			wait = SDL_min(wait, getTicksUntilFrame());
+		}
+		else if (mMode == FRAME_VSYNC || mRedraw)
+		{
+			wait = 0;
+		}
+		SDL_Delay(SDL_min(wait, REPLAY_MAX_WAIT));
+		mWaited = true;
+		gotEvent = mInput->nextEvent(e);
+	}
+
+	if (gotEvent)
+	{
+		mRedraw = true;
+	}
+	else
+	{
+		mWaited = false;
+	}
+	return gotEvent;
+}
+
+bool FrameScheduler::shouldDraw()
+{
+	if (!mDrawEnabled)
+	{
+		return false;
+	}
+	if (mMode == FRAME_EVENT_DRIVEN)
+	{
+		return mRedraw;
+	}
+	return true;
+}
+
+void FrameScheduler::requestRedraw()
+{
+	mRedraw = true;
+}
+
+void FrameScheduler::setInputLog(InputLog* input)
+{
+	mInput = input;
+}
+
+void FrameScheduler::setDrawEnabled(bool enabled)
+{
+	mDrawEnabled = enabled;
+}
+
+void FrameScheduler::frameDone()
+{
+	mRedraw = false;
+
+	//Schedule next frame, dropping frames rather than bursting to catch up
+	Uint64 now = mClock.getMicroseconds();
+	mNextFrame += mFrameMicros;
+	if (mNextFrame < now)
+	{
+		mNextFrame = now + mFrameMicros;
+	}
+}
+
+Uint32 FrameScheduler::getTicksUntilFrame()
+{
+	Uint64 now = mClock.getMicroseconds();
+	return mNextFrame > now ? (Uint32)((mNextFrame - now + 999) / 1000) : 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SDL.h>
+#include "InputLog.h"
+#include "GameClock.h"
+
+//How the main loop paces its frames
+enum FrameMode
+{
+	FRAME_VSYNC = 0,		//poll events, SDL_RenderPresent blocks on vsync
+	FRAME_FIXED_FPS = 1,	//wait for events until the next frame is due
+	FRAME_EVENT_DRIVEN = 2	//sleep until an event arrives, draw only then
+};
+
+//Paces the main loop so idle screens do not spin a core
+class FrameScheduler
+{
+public:
+	//Initializes variables
+	FrameScheduler();
+
+	//Sets pacing mode, target FPS is used by FRAME_FIXED_FPS
+	void setMode(FrameMode mode, int targetFps = 60);
+	FrameMode getMode();
+
+	//Gets the next event of this frame, waiting as the mode requires
+	//Returns false once the frame's events are exhausted
+	bool pollEvent(SDL_Event* e);
+
+	//Checks if the current frame has to be drawn
+	bool shouldDraw();
+
+	//Asks for a redraw in FRAME_EVENT_DRIVEN mode
+	void requestRedraw();
+
+	//Sets log real events are recorded to, or replayed events come from
+	void setInputLog(InputLog* input);
+
+	//Turns drawing off for headless replays
+	void setDrawEnabled(bool enabled);
+
+	//Marks the frame as presented and schedules the next one
+	void frameDone();
+
+private:
+	//Gets the next replayed event, real input other than quit is dropped
+	bool pollReplayEvent(SDL_Event* e);
+
+	//Current pacing mode
+	FrameMode mMode;
+
+	//Gets milliseconds until the next frame is due, rounded up, 0 if due
+	Uint32 getTicksUntilFrame();
+
+	//Microseconds per frame and when the next frame is due, whole milliseconds would run 60 fps at 62.5
+	GameClock mClock;
+	Uint64 mFrameMicros;
+	Uint64 mNextFrame;
+
+	//Whether this frame already blocked for its first event
+	bool mWaited;
+
+	//Whether something changed since the last present
+	bool mRedraw;
+
+	//Input recording or replay, NULL for plain live input
+	InputLog* mInput;
+
+	//Whether frames are drawn at all
+	bool mDrawEnabled;
+};
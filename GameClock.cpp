@@ -0,0 +1,24 @@
+#include <SDL.h>
+#include "GameClock.h"
+
+GameClock::GameClock()
+{
+	start();
+}
+
+void GameClock::start()
+{
+	mStartCounter = SDL_GetPerformanceCounter();
+}
+
+Uint64 GameClock::getMicroseconds()
+{
+	return countsToMicroseconds(SDL_GetPerformanceCounter() - mStartCounter);
+}
+
+Uint64 GameClock::countsToMicroseconds(Uint64 counts)
+{
+	//Whole seconds and the remainder separately, counts * 1000000 overflows within hours at 1 GHz
+	Uint64 frequency = SDL_GetPerformanceFrequency();
+	return counts / frequency * 1000000 + counts % frequency * 1000000 / frequency;
+}
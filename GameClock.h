@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL.h>
+
+//Monotonic microsecond clock on SDL_GetPerformanceCounter
+class GameClock
+{
+public:
+	//Initializes a clock started now
+	GameClock();
+
+	//Restarts the clock from zero
+	void start();
+
+	//Gets microseconds since start
+	Uint64 getMicroseconds();
+
+	//Converts performance counter ticks to microseconds without overflowing on fast counters
+	static Uint64 countsToMicroseconds(Uint64 counts);
+
+private:
+	//Counter value at start
+	Uint64 mStartCounter;
+};
@@ -0,0 +1,149 @@
+#include <SDL.h>
+#include "GameRng.h"
+
+//Rotates x left by k bits
+static inline Uint64 rotl(Uint64 x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+GameRng::GameRng(Uint64 seed)
+{
+	this->seed(seed);
+}
+
+void GameRng::seed(Uint64 seed)
+{
+	//Never all zero, splitmix output has no zero cycles
+	mSeed = seed;
+	Uint64 state = seed;
+	for (int i = 0; i < 4; i++)
+	{
+		mState[i] = splitMix(state);
+	}
+}
+
+Uint64 GameRng::getSeed()
+{
+	return mSeed;
+}
+
+Uint64 GameRng::next()
+{
+	Uint64 result = rotl(mState[1] * 5, 7) * 9;
+	Uint64 t = mState[1] << 17;
+
+	mState[2] ^= mState[0];
+	mState[3] ^= mState[1];
+	mState[1] ^= mState[2];
+	mState[0] ^= mState[3];
+	mState[2] ^= t;
+	mState[3] = rotl(mState[3], 45);
+
+	return result;
+}
+
+Uint32 GameRng::nextBelow(Uint32 bound)
+{
+	if (bound == 0)
+	{
+		return 0;
+	}
+
+	//Lemire's multiply-shift, redraws the few values that would make low results more likely
+	Uint64 product = (next() >> 32) * bound;
+	Uint32 low = (Uint32)product;
+	if (low < bound)
+	{
+		Uint32 threshold = (0u - bound) % bound;
+		while (low < threshold)
+		{
+			product = (next() >> 32) * bound;
+			low = (Uint32)product;
+		}
+	}
+	return (Uint32)(product >> 32);
+}
+
+float GameRng::nextFloat()
+{
+	//Top 24 bits fill a float mantissa exactly
+	return (next() >> 40) * (1.0f / 16777216.0f);
+}
+
+Uint64 GameRng::splitMix(Uint64& state)
+{
+	Uint64 z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+GameRngBatch::GameRngBatch(Uint64 seed)
+{
+	this->seed(seed);
+}
+
+void GameRngBatch::seed(Uint64 seed)
+{
+	//One splitmix stream feeds every lane in turn
+	Uint64 state = seed;
+	for (int lane = 0; lane < GAME_RNG_LANES; lane++)
+	{
+		mState0[lane] = GameRng::splitMix(state);
+		mState1[lane] = GameRng::splitMix(state);
+		mState2[lane] = GameRng::splitMix(state);
+		mState3[lane] = GameRng::splitMix(state);
+	}
+}
+
+void GameRngBatch::step(Uint64* out)
+{
+	//Same xoshiro256** step as GameRng, one lane per vector element
+	for (int lane = 0; lane < GAME_RNG_LANES; lane++)
+	{
+		out[lane] = rotl(mState1[lane] * 5, 7) * 9;
+		Uint64 t = mState1[lane] << 17;
+
+		mState2[lane] ^= mState0[lane];
+		mState3[lane] ^= mState1[lane];
+		mState1[lane] ^= mState2[lane];
+		mState0[lane] ^= mState3[lane];
+		mState2[lane] ^= t;
+		mState3[lane] = rotl(mState3[lane], 45);
+	}
+}
+
+void GameRngBatch::fill(Uint64* out, int count)
+{
+	int i = 0;
+	for (; i + GAME_RNG_LANES <= count; i += GAME_RNG_LANES)
+	{
+		step(out + i);
+	}
+
+	//Partial last block
+	if (i < count)
+	{
+		Uint64 block[GAME_RNG_LANES];
+		step(block);
+		for (int lane = 0; i < count; i++, lane++)
+		{
+			out[i] = block[lane];
+		}
+	}
+}
+
+void GameRngBatch::fillBelow(Uint32* out, int count, Uint32 bound)
+{
+	Uint64 block[GAME_RNG_LANES];
+	for (int i = 0; i < count; i += GAME_RNG_LANES)
+	{
+		step(block);
+		for (int lane = 0; lane < GAME_RNG_LANES && i + lane < count; lane++)
+		{
+			//64 random bits times bound, no branches so lanes stay in step
+			out[i + lane] = (Uint32)(((block[lane] >> 32) * bound + (((block[lane] & 0xFFFFFFFFULL) * bound) >> 32)) >> 32);
+		}
+	}
+}
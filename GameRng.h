@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL.h>
+
+//Lanes stepped together by GameRngBatch, wide enough for 256-bit vectors of 64-bit words
+const int GAME_RNG_LANES = 4;
+
+//xoshiro256** generator, seeded explicitly so a session can be replayed from its seed
+//Also usable as a C++11 uniform random bit generator with <random> distributions
+class GameRng
+{
+public:
+	typedef Uint64 result_type;
+
+	//Initializes generator from a seed
+	GameRng(Uint64 seed = 0);
+
+	//Restarts the sequence from a seed
+	void seed(Uint64 seed);
+
+	//Gets seed the sequence started from
+	Uint64 getSeed();
+
+	//Gets next 64 random bits
+	Uint64 next();
+
+	//Gets a number in [0, bound) without modulo bias, 0 if bound is 0
+	Uint32 nextBelow(Uint32 bound);
+
+	//Gets a number in [0, 1)
+	float nextFloat();
+
+	//Uniform random bit generator interface
+	static result_type min() { return 0; }
+	static result_type max() { return ~(result_type)0; }
+	result_type operator()() { return next(); }
+
+	//Expands a seed into well mixed state words
+	static Uint64 splitMix(Uint64& state);
+
+private:
+	Uint64 mState[4];
+	Uint64 mSeed;
+};
+
+//GAME_RNG_LANES independent xoshiro256** streams kept as structure of arrays
+//Every lane runs the same operations, so fill compiles to vector code
+class GameRngBatch
+{
+public:
+	//Initializes lanes from a seed, lane streams don't overlap in practice
+	GameRngBatch(Uint64 seed = 0);
+
+	//Restarts every lane from a seed
+	void seed(Uint64 seed);
+
+	//Fills out with random words, count is rounded up to a multiple of GAME_RNG_LANES internally
+	void fill(Uint64* out, int count);
+
+	//Fills out with numbers in [0, bound), multiply-shift ranged so bias is below 2^-32
+	void fillBelow(Uint32* out, int count, Uint32 bound);
+
+private:
+	//Advances every lane one step into out
+	void step(Uint64* out);
+
+	//State word i of every lane
+	Uint64 mState0[GAME_RNG_LANES];
+	Uint64 mState1[GAME_RNG_LANES];
+	Uint64 mState2[GAME_RNG_LANES];
+	Uint64 mState3[GAME_RNG_LANES];
+};
@@ -0,0 +1,99 @@
+#include <SDL.h>
+#include <string.h>
+#include "GameSession.h"
+
+GameSession::GameSession(int id, int columns, int rows, Uint64 seed, const DifficultyTable* table)
+	: mEngine(columns * rows, seed)
+{
+	mId = id;
+	mState = INTRO_SCREEN;
+	mColumns = columns;
+	mRows = rows;
+	mEngine.setDifficultyTable(table);
+}
+
+ClickResult GameSession::click(int cell, Uint64 micros)
+{
+	if (cell < 0)
+	{
+		return CLICK_IGNORED;
+	}
+
+	if (mState == INTRO_SCREEN)
+	{
+		//Time spent on the intro is not part of the game
+		mState = IN_GAME;
+		mEngine.reset(micros);
+	}
+	else if (mState == IN_GAME)
+	{
+		ClickResult result = mEngine.applyClick(cell, micros);
+		if (result == CLICK_VICTORY)
+		{
+			mState = VICTORY_SCREEN;
+		}
+		else if (result == CLICK_WRONG)
+		{
+			mState = GAME_OVER;
+		}
+		return result;
+	}
+	else if (mState == GAME_OVER || mState == VICTORY_SCREEN)
+	{
+		//restart the game
+		mState = INTRO_SCREEN;
+	}
+	return CLICK_IGNORED;
+}
+
+void GameSession::quit()
+{
+	mState = QUIT_GAME;
+}
+
+void GameSession::step(Uint64 micros)
+{
+	mEngine.step(micros);
+}
+
+void GameSession::writeBoard(BoardMessage* message)
+{
+	memset(message, 0, sizeof(BoardMessage));
+	message->session = mId;
+	message->round = mEngine.getRound();
+	message->state = (Uint8)mState;
+	message->columns = (Uint8)mColumns;
+	message->rows = (Uint8)mRows;
+	message->level = (Uint8)mEngine.getLevel();
+	message->score = mEngine.getScore();
+	message->oddCell = mEngine.getOddCell();
+	message->baseColor = mEngine.getBaseColor();
+	message->oddColor = mEngine.getOddColor();
+	message->elapsedSeconds = mEngine.getElapsedSeconds();
+	message->winTimeMs = (Uint32)(mEngine.getWinTime() * 1000.0 + 0.5);
+}
+
+int GameSession::getId()
+{
+	return mId;
+}
+
+int GameSession::getState()
+{
+	return mState;
+}
+
+int GameSession::getColumns()
+{
+	return mColumns;
+}
+
+int GameSession::getRows()
+{
+	return mRows;
+}
+
+ColorGameEngine& GameSession::getEngine()
+{
+	return mEngine;
+}
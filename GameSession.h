@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL.h>
+#include "ColorGameEngine.h"
+#include "DifficultyTable.h"
+
+//Screens a session can be on
+const int INTRO_SCREEN = 0;
+const int IN_GAME = 1;
+const int GAME_OVER = 2;
+const int QUIT_GAME = 3;
+const int VICTORY_SCREEN = 4;
+
+//Board state sent to a player after every change, all a client needs to draw the screen
+struct BoardMessage
+{
+	Uint32 session;
+	Uint32 round;
+	Uint8 state;
+	Uint8 columns;
+	Uint8 rows;
+	Uint8 level;
+	Uint32 score;
+	Uint32 oddCell;
+	SDL_Color baseColor;
+	SDL_Color oddColor;
+	Uint32 elapsedSeconds;
+	Uint32 winTimeMs;
+};
+
+//Click sent by a player, cell -1 for a click outside the board
+struct ClickMessage
+{
+	Uint32 session;
+	Sint32 cell;
+};
+
+//One player's game: the rules engine and the screen it is on
+//Owns no window or renderer, so any number can run side by side
+class GameSession
+{
+public:
+	//Initializes a session on the intro screen, table may be NULL and must outlive the session
+	GameSession(int id, int columns, int rows, Uint64 seed, const DifficultyTable* table);
+
+	//Handles a click on a cell at the given time in microseconds, moving between screens like the game does
+	//The game clock starts with the click that leaves the intro
+	//Returns the engine's result while in game, CLICK_IGNORED otherwise
+	ClickResult click(int cell, Uint64 micros);
+
+	//Ends the session
+	void quit();
+
+	//Advances the game clock
+	void step(Uint64 micros);
+
+	//Fills in the current board state
+	void writeBoard(BoardMessage* message);
+
+	//Gets session details
+	int getId();
+	int getState();
+	int getColumns();
+	int getRows();
+	ColorGameEngine& getEngine();
+
+private:
+	int mId;
+	int mState;
+	int mColumns;
+	int mRows;
+	ColorGameEngine mEngine;
+};
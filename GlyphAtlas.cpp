@@ -0,0 +1,172 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <string>
+#include "GlyphAtlas.h"
+
+GlyphAtlas::GlyphAtlas()
+{
+	//initialize
+	mTexture = NULL;
+	mHeight = 0;
+	mCellHeight = 0;
+	for (int i = 0; i < GLYPH_COUNT; i++)
+	{
+		mGlyphClips[i].x = 0;
+		mGlyphClips[i].y = 0;
+		mGlyphClips[i].w = 0;
+		mGlyphClips[i].h = 0;
+		mGlyphAdvances[i] = 0;
+	}
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	//Deallocates memory, calls free
+	free();
+}
+
+bool GlyphAtlas::loadFromFont(TTF_Font* gFont, SDL_Color textColor, SDL_Color bgColor, SDL_Renderer* gRenderer)
+{
+	SDL_Surface* atlasSurface = rasterize(gFont, textColor, bgColor);
+	if (atlasSurface == NULL)
+	{
+		free();
+		return false;
+	}
+
+	bool success = loadFromSurface(atlasSurface, gRenderer);
+	SDL_FreeSurface(atlasSurface);
+	return success;
+}
+
+SDL_Surface* GlyphAtlas::rasterize(TTF_Font* gFont, SDL_Color textColor, SDL_Color bgColor)
+{
+	//Rasterize every glyph once
+	SDL_Surface* glyphSurfaces[GLYPH_COUNT];
+	int cellWidth = 0;
+	int cellHeight = TTF_FontHeight(gFont);
+	for (int i = 0; i < GLYPH_COUNT; i++)
+	{
+		Uint16 ch = (Uint16)(GLYPH_FIRST + i);
+		glyphSurfaces[i] = TTF_RenderGlyph_Shaded(gFont, ch, textColor, bgColor);
+
+		int advance = 0;
+		if (TTF_GlyphMetrics(gFont, ch, NULL, NULL, NULL, NULL, &advance) == -1)
+		{
+			advance = glyphSurfaces[i] != NULL ? glyphSurfaces[i]->w : 0;
+		}
+		mGlyphAdvances[i] = advance;
+
+		if (glyphSurfaces[i] != NULL)
+		{
+			if (glyphSurfaces[i]->w > cellWidth)
+				cellWidth = glyphSurfaces[i]->w;
+			if (glyphSurfaces[i]->h > cellHeight)
+				cellHeight = glyphSurfaces[i]->h;
+		}
+	}
+
+	//Pack glyphs into a grid on one surface
+	int rows = (GLYPH_COUNT + GLYPH_ATLAS_COLUMNS - 1) / GLYPH_ATLAS_COLUMNS;
+	SDL_Surface* atlasSurface = SDL_CreateRGBSurface(0, cellWidth * GLYPH_ATLAS_COLUMNS, cellHeight * rows, 32,
+		0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	if (atlasSurface == NULL)
+	{
+		printf("Unable to create glyph atlas surface! SDL Error: %s\n", SDL_GetError());
+	}
+	else
+	{
+		SDL_FillRect(atlasSurface, NULL, SDL_MapRGBA(atlasSurface->format, bgColor.r, bgColor.g, bgColor.b, 0xFF));
+		for (int i = 0; i < GLYPH_COUNT; i++)
+		{
+			SDL_Rect clip = { (i % GLYPH_ATLAS_COLUMNS) * cellWidth, (i / GLYPH_ATLAS_COLUMNS) * cellHeight, 0, 0 };
+			if (glyphSurfaces[i] != NULL)
+			{
+				clip.w = glyphSurfaces[i]->w;
+				clip.h = glyphSurfaces[i]->h;
+				SDL_Rect dest = clip;
+				SDL_BlitSurface(glyphSurfaces[i], NULL, atlasSurface, &dest);
+			}
+			mGlyphClips[i] = clip;
+		}
+		mCellHeight = cellHeight;
+	}
+
+	//Get rid of glyph surfaces
+	for (int i = 0; i < GLYPH_COUNT; i++)
+	{
+		if (glyphSurfaces[i] != NULL)
+			SDL_FreeSurface(glyphSurfaces[i]);
+	}
+
+	return atlasSurface;
+}
+
+bool GlyphAtlas::loadFromSurface(SDL_Surface* atlasSurface, SDL_Renderer* gRenderer)
+{
+	//Get rid of preexisting atlas
+	free();
+
+	//Create texture from atlas pixels
+	mTexture = SDL_CreateTextureFromSurface(gRenderer, atlasSurface);
+	if (mTexture == NULL)
+	{
+		printf("Unable to create glyph atlas texture! SDL Error: %s\n", SDL_GetError());
+	}
+	else
+	{
+		mHeight = mCellHeight;
+	}
+
+	//Return success
+	return mTexture != NULL;
+}
+
+//Deallocates atlas texture
+void GlyphAtlas::free()
+{
+	if (mTexture != NULL)
+	{
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mHeight = 0;
+	}
+}
+
+void GlyphAtlas::render(const char* text, int x, int y, SDL_Renderer* gRenderer)
+{
+	//Every quad samples the same texture, so the renderer can batch them
+	int penX = x;
+	for (const char* c = text; *c != '\0'; c++)
+	{
+		int index = (unsigned char)*c - GLYPH_FIRST;
+		if (index < 0 || index >= GLYPH_COUNT)
+			continue;
+
+		SDL_Rect* clip = &mGlyphClips[index];
+		if (clip->w > 0)
+		{
+			SDL_Rect renderQuad = { penX, y, clip->w, clip->h };
+			SDL_RenderCopy(gRenderer, mTexture, clip, &renderQuad);
+		}
+		penX += mGlyphAdvances[index];
+	}
+}
+
+//Gets dimensions of a string drawn with the atlas
+int GlyphAtlas::getTextWidth(const char* text)
+{
+	int width = 0;
+	for (const char* c = text; *c != '\0'; c++)
+	{
+		int index = (unsigned char)*c - GLYPH_FIRST;
+		if (index >= 0 && index < GLYPH_COUNT)
+			width += mGlyphAdvances[index];
+	}
+	return width;
+}
+int GlyphAtlas::getHeight()
+{
+	return mHeight;
+}
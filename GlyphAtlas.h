@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+
+//First and last printable ASCII characters kept in the atlas
+const int GLYPH_FIRST = 32;
+const int GLYPH_LAST = 126;
+const int GLYPH_COUNT = GLYPH_LAST - GLYPH_FIRST + 1;
+
+//Glyphs per atlas row
+const int GLYPH_ATLAS_COLUMNS = 16;
+
+//Font glyph atlas, rasterizes the font once and draws strings from one texture
+class GlyphAtlas
+{
+public:
+	//Initializes variables
+	GlyphAtlas();
+
+	//Deallocates memory, calls free
+	~GlyphAtlas();
+
+	//Rasterizes every printable glyph of the font into a single texture
+	bool loadFromFont(TTF_Font* gFont, SDL_Color textColor, SDL_Color bgColor, SDL_Renderer* gRenderer);
+
+	//Rasterizes glyphs into an atlas surface without touching the renderer, safe off the render thread
+	//Caller frees the returned surface
+	SDL_Surface* rasterize(TTF_Font* gFont, SDL_Color textColor, SDL_Color bgColor);
+
+	//Uploads an atlas surface made by rasterize
+	bool loadFromSurface(SDL_Surface* atlasSurface, SDL_Renderer* gRenderer);
+
+	//Deallocates atlas texture
+	void free();
+
+	//Renders string at given point, one quad per glyph from the atlas texture
+	void render(const char* text, int x, int y, SDL_Renderer* gRenderer);
+
+	//Gets dimensions of a string drawn with the atlas
+	int getTextWidth(const char* text);
+	int getHeight();
+
+private:
+	//The atlas hardware texture
+	SDL_Texture* mTexture;
+
+	//Location of each glyph in the atlas and how far it moves the pen
+	SDL_Rect mGlyphClips[GLYPH_COUNT];
+	int mGlyphAdvances[GLYPH_COUNT];
+
+	//Line height, and the one rasterized but not yet uploaded
+	int mHeight;
+	int mCellHeight;
+};
@@ -0,0 +1,137 @@
+#include <SDL.h>
+#include <vector>
+#include "GridHitTest.h"
+
+//Hash table size for arbitrary layouts, power of two
+const int HIT_TEST_BUCKETS = 1024;
+
+GridHitTest::GridHitTest()
+{
+	//initialize
+	mUniform = true;
+	mLayout = NULL;
+	mBoardRect.x = 0;
+	mBoardRect.y = 0;
+	mBoardRect.w = 0;
+	mBoardRect.h = 0;
+	mColumns = 1;
+	mRows = 1;
+	mBucketSize = 64;
+}
+
+void GridHitTest::setLayout(BoardLayout* layout)
+{
+	mUniform = true;
+	mLayout = layout;
+	mCells.clear();
+	mBuckets.clear();
+}
+
+void GridHitTest::setUniformGrid(SDL_Rect boardRect, int columns, int rows)
+{
+	mUniform = true;
+	mLayout = NULL;
+	mBoardRect = boardRect;
+	mColumns = columns;
+	mRows = rows;
+	mCells.clear();
+	mBuckets.clear();
+}
+
+void GridHitTest::setCells(const std::vector<SDL_Rect>& cells, int bucketSize)
+{
+	mUniform = false;
+	mLayout = NULL;
+	mCells = cells;
+	mBucketSize = bucketSize > 0 ? bucketSize : 64;
+	mBuckets.assign(HIT_TEST_BUCKETS, std::vector<int>());
+
+	//Insert each cell into every bucket it overlaps
+	for (int i = 0; i < (int)mCells.size(); i++)
+	{
+		SDL_Rect* cell = &mCells[i];
+		if (cell->w <= 0 || cell->h <= 0)
+			continue;
+
+		int x1 = cell->x / mBucketSize;
+		int y1 = cell->y / mBucketSize;
+		int x2 = (cell->x + cell->w - 1) / mBucketSize;
+		int y2 = (cell->y + cell->h - 1) / mBucketSize;
+		for (int by = y1; by <= y2; by++)
+		{
+			for (int bx = x1; bx <= x2; bx++)
+			{
+				std::vector<int>& bucket = mBuckets[bucketIndex(bx, by)];
+				if (bucket.empty() || bucket.back() != i)
+					bucket.push_back(i);
+			}
+		}
+	}
+}
+
+int GridHitTest::bucketIndex(int bucketX, int bucketY)
+{
+	unsigned int hash = (unsigned int)bucketX * 73856093u ^ (unsigned int)bucketY * 19349663u;
+	return (int)(hash & (HIT_TEST_BUCKETS - 1));
+}
+
+int GridHitTest::cellAt(int x, int y)
+{
+	if (mUniform)
+	{
+		//Layout is only recomputed on resize, so reading it here is cheap
+		if (mLayout != NULL)
+		{
+			mBoardRect = mLayout->getBoardRect();
+			mColumns = mLayout->getColumns();
+			mRows = mLayout->getRows();
+		}
+
+		//Outside the board
+		if (mBoardRect.w <= 0 || mBoardRect.h <= 0 ||
+			x < mBoardRect.x || x >= mBoardRect.x + mBoardRect.w ||
+			y < mBoardRect.y || y >= mBoardRect.y + mBoardRect.h)
+		{
+			return -1;
+		}
+
+		int column = (x - mBoardRect.x) * mColumns / mBoardRect.w;
+		int row = (y - mBoardRect.y) * mRows / mBoardRect.h;
+		return row * mColumns + column;
+	}
+
+	if (x < 0 || y < 0 || mBuckets.empty())
+	{
+		return -1;
+	}
+
+	//Only the few cells sharing this bucket need an exact test
+	std::vector<int>& bucket = mBuckets[bucketIndex(x / mBucketSize, y / mBucketSize)];
+	for (int i = 0; i < (int)bucket.size(); i++)
+	{
+		SDL_Rect* cell = &mCells[bucket[i]];
+		if (x >= cell->x && x < cell->x + cell->w && y >= cell->y && y < cell->y + cell->h)
+		{
+			return bucket[i];
+		}
+	}
+	return -1;
+}
+
+int GridHitTest::handleEvent(SDL_Event* e)
+{
+	//Use the coordinates carried by the event itself
+	if (e->type == SDL_MOUSEBUTTONUP)
+	{
+		int x = e->button.x;
+		int y = e->button.y;
+
+		//Events are in window points, the layout is in pixels
+		if (mLayout != NULL)
+		{
+			mLayout->toPixels(&x, &y);
+		}
+		return cellAt(x, y);
+	}
+	return -1;
+}
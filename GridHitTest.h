@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include "BoardLayout.h"
+
+//Maps click coordinates to board cells in constant time
+class GridHitTest
+{
+public:
+	//Initializes variables
+	GridHitTest();
+
+	//Uses the uniform grid of a layout, follows it through resizes
+	void setLayout(BoardLayout* layout);
+
+	//Uses a uniform grid covering the board rect, cell is found by division
+	void setUniformGrid(SDL_Rect boardRect, int columns, int rows);
+
+	//Uses arbitrary cell rects, looked up through a spatial hash
+	void setCells(const std::vector<SDL_Rect>& cells, int bucketSize = 64);
+
+	//Gets the cell under a point, -1 if there is none
+	int cellAt(int x, int y);
+
+	//Gets the cell clicked by a mouse button up event, -1 otherwise
+	int handleEvent(SDL_Event* e);
+
+private:
+	//Gets hash bucket of a bucket coordinate
+	int bucketIndex(int bucketX, int bucketY);
+
+	//Whether arbitrary cells are in use
+	bool mUniform;
+
+	//Shared layout, overrides the fixed uniform grid
+	BoardLayout* mLayout;
+
+	//Uniform grid
+	SDL_Rect mBoardRect;
+	int mColumns;
+	int mRows;
+
+	//Arbitrary layout, cells hashed by the buckets they overlap
+	std::vector<SDL_Rect> mCells;
+	std::vector< std::vector<int> > mBuckets;
+	int mBucketSize;
+};
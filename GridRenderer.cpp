@@ -0,0 +1,130 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+#include "GridRenderer.h"
+
+GridRenderer::GridRenderer()
+{
+	//initialize
+	mLayout = NULL;
+	mBaseColor.r = mBaseColor.g = mBaseColor.b = mBaseColor.a = 255;
+	mOddColor = mBaseColor;
+	mOddCell = 0;
+	mDirty = true;
+	mColorsDirty = true;
+}
+
+void GridRenderer::setLayout(BoardLayout* layout)
+{
+	mLayout = layout;
+	mDirty = true;
+}
+
+void GridRenderer::invalidate()
+{
+	mDirty = true;
+}
+
+void GridRenderer::setColors(SDL_Color baseColor, SDL_Color oddColor, int oddCell)
+{
+	//Compare channel by channel, SDL_Color has no operator==
+	if (baseColor.r != mBaseColor.r || baseColor.g != mBaseColor.g || baseColor.b != mBaseColor.b || baseColor.a != mBaseColor.a ||
+		oddColor.r != mOddColor.r || oddColor.g != mOddColor.g || oddColor.b != mOddColor.b || oddColor.a != mOddColor.a ||
+		oddCell != mOddCell)
+	{
+		mBaseColor = baseColor;
+		mOddColor = oddColor;
+		mOddCell = oddCell;
+		mColorsDirty = true;
+	}
+}
+
+void GridRenderer::rebuild()
+{
+	int total = mLayout != NULL ? mLayout->getColumns() * mLayout->getRows() : 0;
+	mCells.resize(total);
+	mVertices.resize(total * 4);
+	mIndices.resize(total * 6);
+
+	for (int i = 0; i < total; i++)
+	{
+		//Leave a one pixel border, same as the old per-cell outline
+		SDL_Rect cell = mLayout->getCellRect(i);
+		cell.x += 1;
+		cell.y += 1;
+		cell.w -= 2;
+		cell.h -= 2;
+		mCells[i] = cell;
+
+		SDL_Color color = (i == mOddCell) ? mOddColor : mBaseColor;
+		SDL_Vertex* quad = &mVertices[i * 4];
+		for (int v = 0; v < 4; v++)
+		{
+			quad[v].position.x = (float)(cell.x + ((v == 1 || v == 2) ? cell.w : 0));
+			quad[v].position.y = (float)(cell.y + ((v >= 2) ? cell.h : 0));
+			quad[v].color = color;
+			quad[v].tex_coord.x = 0.0f;
+			quad[v].tex_coord.y = 0.0f;
+		}
+
+		int* index = &mIndices[i * 6];
+		index[0] = i * 4;
+		index[1] = i * 4 + 1;
+		index[2] = i * 4 + 2;
+		index[3] = i * 4;
+		index[4] = i * 4 + 2;
+		index[5] = i * 4 + 3;
+	}
+
+	mDirty = false;
+	mColorsDirty = false;
+}
+
+void GridRenderer::recolor()
+{
+	int total = (int)mCells.size();
+	for (int i = 0; i < total; i++)
+	{
+		SDL_Color color = (i == mOddCell) ? mOddColor : mBaseColor;
+		SDL_Vertex* quad = &mVertices[i * 4];
+		quad[0].color = color;
+		quad[1].color = color;
+		quad[2].color = color;
+		quad[3].color = color;
+	}
+	mColorsDirty = false;
+}
+
+void GridRenderer::render(SDL_Renderer* gRenderer)
+{
+	if (mDirty)
+	{
+		rebuild();
+	}
+	else if (mColorsDirty)
+	{
+		recolor();
+	}
+	if (mCells.empty())
+	{
+		return;
+	}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	//Whole board in one draw call
+	if (SDL_RenderGeometry(gRenderer, NULL, &mVertices[0], (int)mVertices.size(), &mIndices[0], (int)mIndices.size()) == 0)
+	{
+		return;
+	}
+	printf("Unable to render board geometry! SDL Error: %s\n", SDL_GetError());
+#endif
+
+	//Fallback, one batch for the base color and one rect for the odd cell
+	SDL_SetRenderDrawColor(gRenderer, mBaseColor.r, mBaseColor.g, mBaseColor.b, mBaseColor.a);
+	SDL_RenderFillRects(gRenderer, &mCells[0], (int)mCells.size());
+	if (mOddCell >= 0 && mOddCell < (int)mCells.size())
+	{
+		SDL_SetRenderDrawColor(gRenderer, mOddColor.r, mOddColor.g, mOddColor.b, mOddColor.a);
+		SDL_RenderFillRect(gRenderer, &mCells[mOddCell]);
+	}
+}
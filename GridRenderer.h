@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include "BoardLayout.h"
+
+//Draws the color board as one batch of geometry, whatever the cell count
+class GridRenderer
+{
+public:
+	//Initializes variables
+	GridRenderer();
+
+	//Sets layout the cells are read from
+	void setLayout(BoardLayout* layout);
+
+	//Rebuilds buffers on the next render, call after the layout changes
+	void invalidate();
+
+	//Sets colors of the round and which cell is the odd one
+	void setColors(SDL_Color baseColor, SDL_Color oddColor, int oddCell);
+
+	//Draws every cell in a single submission
+	void render(SDL_Renderer* gRenderer);
+
+private:
+	//Rebuilds cell rects and vertex buffer after a layout change
+	void rebuild();
+
+	//Rewrites vertex colors only, a new round keeps every position
+	void recolor();
+
+	//Board layout
+	BoardLayout* mLayout;
+
+	//Round colors
+	SDL_Color mBaseColor;
+	SDL_Color mOddColor;
+	int mOddCell;
+
+	//Whether the buffers or just their colors are out of date
+	bool mDirty;
+	bool mColorsDirty;
+
+	//Cell fill rects, inset one pixel so the cleared background shows as grid lines
+	std::vector<SDL_Rect> mCells;
+
+	//One quad per cell
+	std::vector<SDL_Vertex> mVertices;
+	std::vector<int> mIndices;
+};
@@ -0,0 +1,120 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include "HudLabel.h"
+
+HudLabel::HudLabel(std::string prefix, std::string suffix)
+{
+	//initialize
+	mAtlas = NULL;
+	mFont = NULL;
+	mTextColor.r = mTextColor.g = mTextColor.b = 0;
+	mTextColor.a = 255;
+	mBgColor.r = mBgColor.g = mBgColor.b = 255;
+	mBgColor.a = 255;
+	mPrefix = prefix;
+	mSuffix = suffix;
+	mValue = 0;
+	mDecimals = 0;
+	mHasValue = false;
+	mText[0] = '\0';
+}
+
+void HudLabel::setFont(TTF_Font* gFont, SDL_Color textColor, SDL_Color bgColor)
+{
+	mFont = gFont;
+	mTextColor = textColor;
+	mBgColor = bgColor;
+	invalidate();
+}
+
+void HudLabel::setAtlas(GlyphAtlas* atlas)
+{
+	mAtlas = atlas;
+	mTexture.free();
+	invalidate();
+}
+
+bool HudLabel::setValue(int value, SDL_Renderer* gRenderer)
+{
+	return setFixed(value, 0, gRenderer);
+}
+
+bool HudLabel::setValue(double value, int decimals, SDL_Renderer* gRenderer)
+{
+	int scale = 1;
+	for (int i = 0; i < decimals; i++)
+	{
+		scale *= 10;
+	}
+	return setFixed((int)floor(value * scale + 0.5), decimals, gRenderer);
+}
+
+bool HudLabel::setFixed(int value, int decimals, SDL_Renderer* gRenderer)
+{
+	//Nothing to do if the value is already on screen
+	if (mHasValue && value == mValue && decimals == mDecimals)
+	{
+		return false;
+	}
+
+	mValue = value;
+	mDecimals = decimals;
+	mHasValue = true;
+	if (decimals == 0)
+	{
+		snprintf(mText, sizeof(mText), "%s%d%s", mPrefix.c_str(), value, mSuffix.c_str());
+	}
+	else
+	{
+		int scale = 1;
+		for (int i = 0; i < decimals; i++)
+		{
+			scale *= 10;
+		}
+		snprintf(mText, sizeof(mText), "%s%.*f%s", mPrefix.c_str(), decimals, (double)value / scale, mSuffix.c_str());
+	}
+
+	//Atlas labels are drawn straight from the text
+	if (mAtlas == NULL)
+	{
+		mTexture.loadFromRenderedText(mText, mTextColor, mBgColor, mFont, gRenderer);
+	}
+	return true;
+}
+
+void HudLabel::invalidate()
+{
+	mHasValue = false;
+}
+
+//Deallocates texture
+void HudLabel::free()
+{
+	mTexture.free();
+	invalidate();
+}
+
+void HudLabel::render(int x, int y, SDL_Renderer* gRenderer)
+{
+	if (mAtlas != NULL)
+	{
+		mAtlas->render(mText, x, y, gRenderer);
+	}
+	else
+	{
+		mTexture.render(x, y, gRenderer);
+	}
+}
+
+//Gets label dimensions
+int HudLabel::getWidth()
+{
+	return mAtlas != NULL ? mAtlas->getTextWidth(mText) : mTexture.getWidth();
+}
+int HudLabel::getHeight()
+{
+	return mAtlas != NULL ? mAtlas->getHeight() : mTexture.getHeight();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include "LTexture.h"
+#include "GlyphAtlas.h"
+
+//Numeric text label that only re-renders when its value changes
+class HudLabel
+{
+public:
+	//Initializes variables, label reads as prefix + value + suffix
+	HudLabel(std::string prefix, std::string suffix = "");
+
+	//Renders with its own texture using the given font
+	void setFont(TTF_Font* gFont, SDL_Color textColor, SDL_Color bgColor);
+
+	//Renders from a shared glyph atlas instead of its own texture
+	void setAtlas(GlyphAtlas* atlas);
+
+	//Sets displayed value, returns true if the label had to be regenerated
+	bool setValue(int value, SDL_Renderer* gRenderer);
+
+	//Sets a fractional value shown with the given number of decimals, only digits that change regenerate
+	bool setValue(double value, int decimals, SDL_Renderer* gRenderer);
+
+	//Forces regeneration on the next setValue
+	void invalidate();
+
+	//Deallocates texture
+	void free();
+
+	//Renders label at given point
+	void render(int x, int y, SDL_Renderer* gRenderer);
+
+	//Gets label dimensions
+	int getWidth();
+	int getHeight();
+
+private:
+	//Shows value / 10^decimals
+	bool setFixed(int value, int decimals, SDL_Renderer* gRenderer);
+
+	//This label's own texture slot
+	LTexture mTexture;
+
+	//Optional shared glyph atlas
+	GlyphAtlas* mAtlas;
+
+	//Font used for the own texture
+	TTF_Font* mFont;
+	SDL_Color mTextColor;
+	SDL_Color mBgColor;
+
+	//Fixed text around the value
+	std::string mPrefix;
+	std::string mSuffix;
+
+	//Last value rendered, scaled by 10^mDecimals
+	int mValue;
+	int mDecimals;
+	bool mHasValue;
+
+	//Last text rendered
+	char mText[64];
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "GameSession.h"
+
+//Draws the in-game frame for a board, so the game can run with or without a display
+//Works from a BoardMessage snapshot, never the live engine, so it can run on the render thread
+class IRenderer
+{
+public:
+	virtual ~IRenderer() {}
+
+	//Draws board and HUD for a board state
+	virtual void renderFrame(const BoardMessage& board) = 0;
+
+	//Forces a full redraw on the next frame
+	virtual void invalidate() = 0;
+};
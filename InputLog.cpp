@@ -0,0 +1,311 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "InputLog.h"
+
+InputLog::InputLog()
+{
+	//initialize
+	mMode = INPUT_LIVE;
+	mFast = false;
+	mFile = NULL;
+	memset(&mHeader, 0, sizeof(mHeader));
+	mNext = 0;
+	mNextState = 0;
+	mDiverged = false;
+	mWindow = NULL;
+	mFastMicros = 0;
+	mEventMicros = 0;
+}
+
+InputLog::~InputLog()
+{
+	//Deallocates memory, calls close
+	close();
+}
+
+bool InputLog::startRecording(std::string path, Uint64 seed, int columns, int rows)
+{
+	close();
+	mFile = fopen(path.c_str(), "wb");
+	if (mFile == NULL)
+	{
+		printf("Unable to write input log %s\n", path.c_str());
+		return false;
+	}
+
+	memcpy(mHeader.magic, INPUT_LOG_MAGIC, 4);
+	mHeader.version = INPUT_LOG_VERSION;
+	mHeader.seed = seed;
+	mHeader.columns = columns;
+	mHeader.rows = rows;
+	fwrite(&mHeader, sizeof(mHeader), 1, mFile);
+	mMode = INPUT_RECORD;
+	return true;
+}
+
+bool InputLog::startReplay(std::string path, bool fast)
+{
+	close();
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		printf("Unable to open input log %s\n", path.c_str());
+		return false;
+	}
+
+	//Whole log is read up front, nothing touches the disk during replay
+	bool valid = fread(&mHeader, sizeof(mHeader), 1, file) == 1 &&
+		memcmp(mHeader.magic, INPUT_LOG_MAGIC, 4) == 0 && mHeader.version >= 1 && mHeader.version <= INPUT_LOG_VERSION;
+	InputRecord record;
+	while (valid && fread(&record, sizeof(record), 1, file) == 1)
+	{
+		mRecords.push_back(record);
+	}
+	fclose(file);
+	if (!valid)
+	{
+		printf("Invalid input log %s\n", path.c_str());
+		mRecords.clear();
+		return false;
+	}
+
+	mMode = INPUT_REPLAY;
+	mFast = fast;
+	mNext = 0;
+	mNextState = 0;
+	mDiverged = false;
+	return true;
+}
+
+void InputLog::setWindow(SDL_Window* window)
+{
+	mWindow = window;
+}
+
+void InputLog::startClock()
+{
+	mClock.start();
+	mFastMicros = 0;
+	mEventMicros = 0;
+}
+
+void InputLog::close()
+{
+	if (mFile != NULL)
+	{
+		fclose(mFile);
+		mFile = NULL;
+	}
+	mRecords.clear();
+	mNext = 0;
+	mNextState = 0;
+	mMode = INPUT_LIVE;
+}
+
+InputMode InputLog::getMode()
+{
+	return mMode;
+}
+
+bool InputLog::isFastReplay()
+{
+	return mMode == INPUT_REPLAY && mFast;
+}
+
+bool InputLog::isReplayFinished()
+{
+	return mMode == INPUT_REPLAY && mNext >= mRecords.size();
+}
+
+Uint64 InputLog::getSeed()
+{
+	return mHeader.seed;
+}
+
+int InputLog::getColumns()
+{
+	return (int)mHeader.columns;
+}
+
+int InputLog::getRows()
+{
+	return (int)mHeader.rows;
+}
+
+void InputLog::write(Uint8 kind, Uint8 detail, Sint32 a, Sint32 b)
+{
+	InputRecord record;
+	record.ticks = (Uint32)(mEventMicros / 1000);
+	record.kind = kind;
+	record.detail = detail;
+	record.micros = (Uint16)(mEventMicros % 1000);
+	record.a = a;
+	record.b = b;
+	fwrite(&record, sizeof(record), 1, mFile);
+}
+
+void InputLog::recordEvent(SDL_Event* e)
+{
+	if (mMode == INPUT_REPLAY)
+	{
+		return;
+	}
+
+	//Game logic sees the same time that gets recorded
+	mEventMicros = getMicros();
+	if (mMode != INPUT_RECORD)
+	{
+		return;
+	}
+
+	//Only what the state machine reacts to, motion is never looked at
+	if (e->type == SDL_QUIT)
+		write(INPUT_QUIT, 0, 0, 0);
+	else if (e->type == SDL_MOUSEBUTTONDOWN)
+		write(INPUT_MOUSE_DOWN, e->button.button, e->button.x, e->button.y);
+	else if (e->type == SDL_MOUSEBUTTONUP)
+		write(INPUT_MOUSE_UP, e->button.button, e->button.x, e->button.y);
+	else if (e->type == SDL_KEYDOWN)
+		write(INPUT_KEY_DOWN, 0, e->key.keysym.sym, 0);
+	else if (e->type == SDL_KEYUP)
+		write(INPUT_KEY_UP, 0, e->key.keysym.sym, 0);
+	else if (e->type == SDL_WINDOWEVENT)
+		write(INPUT_WINDOW, e->window.event, e->window.data1, e->window.data2);
+}
+
+void InputLog::recordState(int state)
+{
+	if (mMode == INPUT_RECORD)
+	{
+		write(INPUT_STATE, 0, state, 0);
+	}
+	else if (mMode == INPUT_REPLAY && !mDiverged)
+	{
+		//States must change in the recorded order, otherwise the replay no longer matches
+		while (mNextState < mRecords.size() && mRecords[mNextState].kind != INPUT_STATE)
+		{
+			mNextState++;
+		}
+		if (mNextState >= mRecords.size() || mRecords[mNextState].a != state)
+		{
+			printf("Replay diverged at %u ms: entered state %d, log has %d\n", getTicks(), state,
+				mNextState < mRecords.size() ? (int)mRecords[mNextState].a : -1);
+			mDiverged = true;
+			return;
+		}
+		mNextState++;
+	}
+}
+
+bool InputLog::nextEvent(SDL_Event* e)
+{
+	//State records are only checked, never delivered
+	while (mNext < mRecords.size() && mRecords[mNext].kind == INPUT_STATE)
+	{
+		mNext++;
+	}
+	if (mNext >= mRecords.size())
+	{
+		return false;
+	}
+
+	const InputRecord& record = mRecords[mNext];
+	if (recordMicros(record) > getMicros())
+	{
+		//Fast replays jump the clock, the event is due next frame
+		if (mFast)
+		{
+			mFastMicros = recordMicros(record);
+		}
+		return false;
+	}
+	mNext++;
+	mEventMicros = recordMicros(record);
+
+	//Rebuild the SDL event
+	memset(e, 0, sizeof(SDL_Event));
+	e->common.timestamp = SDL_GetTicks();
+	Uint32 windowID = mWindow != NULL ? SDL_GetWindowID(mWindow) : 0;
+	switch (record.kind)
+	{
+	case INPUT_QUIT:
+		e->type = SDL_QUIT;
+		break;
+	case INPUT_MOUSE_DOWN:
+	case INPUT_MOUSE_UP:
+		e->type = record.kind == INPUT_MOUSE_DOWN ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+		e->button.windowID = windowID;
+		e->button.button = record.detail;
+		e->button.state = record.kind == INPUT_MOUSE_DOWN ? SDL_PRESSED : SDL_RELEASED;
+		e->button.clicks = 1;
+		e->button.x = record.a;
+		e->button.y = record.b;
+		break;
+	case INPUT_KEY_DOWN:
+	case INPUT_KEY_UP:
+		e->type = record.kind == INPUT_KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+		e->key.windowID = windowID;
+		e->key.state = record.kind == INPUT_KEY_DOWN ? SDL_PRESSED : SDL_RELEASED;
+		e->key.keysym.sym = record.a;
+		break;
+	default:
+		e->type = SDL_WINDOWEVENT;
+		e->window.windowID = windowID;
+		e->window.event = record.detail;
+		e->window.data1 = record.a;
+		e->window.data2 = record.b;
+
+		//Give the real window the recorded size so clicks land on the same cells
+		if (record.detail == SDL_WINDOWEVENT_SIZE_CHANGED && mWindow != NULL)
+		{
+			SDL_SetWindowSize(mWindow, record.a, record.b);
+		}
+		break;
+	}
+	return true;
+}
+
+Uint32 InputLog::getTicksUntilNext()
+{
+	size_t next = mNext;
+	while (next < mRecords.size() && mRecords[next].kind == INPUT_STATE)
+	{
+		next++;
+	}
+	if (next >= mRecords.size())
+	{
+		return 0;
+	}
+	//Round up so a wait never ends just before the event is due
+	Uint64 due = recordMicros(mRecords[next]);
+	Uint64 now = getMicros();
+	return due > now ? (Uint32)((due - now + 999) / 1000) : 0;
+}
+
+Uint32 InputLog::getTicks()
+{
+	return (Uint32)(getMicros() / 1000);
+}
+
+Uint64 InputLog::getMicros()
+{
+	if (isFastReplay())
+	{
+		return mFastMicros;
+	}
+	return mClock.getMicroseconds();
+}
+
+Uint64 InputLog::getEventMicros()
+{
+	return mEventMicros;
+}
+
+Uint64 InputLog::recordMicros(const InputRecord& record)
+{
+	//Version 1 logs always wrote 0 past the millisecond
+	return (Uint64)record.ticks * 1000 + record.micros;
+}
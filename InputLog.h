@@ -0,0 +1,141 @@
+#pragma once
+
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "GameClock.h"
+
+//Input log layout, all fields little endian
+//Header, then InputRecord entries in time order until the end of the file
+const char INPUT_LOG_MAGIC[4] = { 'C', 'G', 'I', 'N' };
+//Version 1 logs have millisecond times only and still replay
+const Uint32 INPUT_LOG_VERSION = 2;
+
+struct InputLogHeader
+{
+	char magic[4];
+	Uint32 version;
+	Uint64 seed;
+	Uint32 columns;
+	Uint32 rows;
+};
+
+//Kinds of records
+enum InputRecordKind
+{
+	INPUT_QUIT = 0,
+	INPUT_MOUSE_DOWN = 1,	//a = x, b = y, detail = button
+	INPUT_MOUSE_UP = 2,
+	INPUT_KEY_DOWN = 3,		//a = key code
+	INPUT_KEY_UP = 4,
+	INPUT_WINDOW = 5,		//a = data1, b = data2, detail = window event
+	INPUT_STATE = 6			//a = game state entered
+};
+
+//One 16 byte record
+struct InputRecord
+{
+	//Milliseconds since the session clock started, plus microseconds past that millisecond
+	Uint32 ticks;
+	Uint8 kind;
+	Uint8 detail;
+	Uint16 micros;
+	Sint32 a;
+	Sint32 b;
+};
+
+//How the session gets its input
+enum InputMode
+{
+	INPUT_LIVE = 0,		//real events only
+	INPUT_RECORD = 1,	//real events, written to a log
+	INPUT_REPLAY = 2	//events read back from a log, real input is ignored
+};
+
+//Records a session's input and state changes, or plays them back
+//Game logic takes its time from here so a replay sees the same clock as the recording
+class InputLog
+{
+public:
+	//Initializes a live session
+	InputLog();
+
+	//Deallocates memory, calls close
+	~InputLog();
+
+	//Starts writing a log, seed and grid are stored so the replay can match them
+	bool startRecording(std::string path, Uint64 seed, int columns, int rows);
+
+	//Loads a log for replay, fast replays skip the waits between events
+	bool startReplay(std::string path, bool fast);
+
+	//Window recorded resizes are applied to during replay
+	void setWindow(SDL_Window* window);
+
+	//Starts the session clock, call once loading is done
+	void startClock();
+
+	//Writes out and closes the log
+	void close();
+
+	//Gets mode and replay settings
+	InputMode getMode();
+	bool isFastReplay();
+
+	//Checks if a replay has delivered every recorded event
+	bool isReplayFinished();
+
+	//Gets seed and grid stored in a replayed log
+	Uint64 getSeed();
+	int getColumns();
+	int getRows();
+
+	//Adds a real event to the log if recording
+	void recordEvent(SDL_Event* e);
+
+	//Records a game state change, during replay checks it against the log instead
+	void recordState(int state);
+
+	//Gets the next recorded event that is due, false once none is due this frame
+	bool nextEvent(SDL_Event* e);
+
+	//Gets milliseconds until the next recorded event is due, 0 if due or finished
+	Uint32 getTicksUntilNext();
+
+	//Gets session clock in milliseconds and microseconds
+	Uint32 getTicks();
+	Uint64 getMicros();
+
+	//Gets time of the event being handled in microseconds, game logic uses this so replays match exactly
+	//Live events are stamped when they are polled
+	Uint64 getEventMicros();
+
+private:
+	//Appends a record
+	void write(Uint8 kind, Uint8 detail, Sint32 a, Sint32 b);
+
+	//Gets a record's time in microseconds
+	static Uint64 recordMicros(const InputRecord& record);
+
+	InputMode mMode;
+	bool mFast;
+
+	//Open log when recording
+	FILE* mFile;
+
+	//Records and read positions when replaying
+	InputLogHeader mHeader;
+	std::vector<InputRecord> mRecords;
+	size_t mNext;
+	size_t mNextState;
+	bool mDiverged;
+
+	//Window resizes are replayed on
+	SDL_Window* mWindow;
+
+	//Session clock, fast replays jump mFastMicros from event to event instead
+	GameClock mClock;
+	Uint64 mFastMicros;
+	Uint64 mEventMicros;
+};
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <cmath>
 #include "LTexture.h"
+#include "CookedTexture.h"
 #include <SDL_ttf.h>
 
 LTexture::LTexture()
@@ -21,12 +22,50 @@ LTexture::~LTexture()
 	free();
 }
 
-	
+LTexture::LTexture(LTexture&& other)
+{
+	//Take over the other texture
+	mTexture = other.mTexture;
+	mWidth = other.mWidth;
+	mHeight = other.mHeight;
+	other.mTexture = NULL;
+	other.mWidth = 0;
+	other.mHeight = 0;
+}
+
+LTexture& LTexture::operator=(LTexture&& other)
+{
+	if (this != &other)
+	{
+		//Get rid of own texture, then take over the other one
+		free();
+		mTexture = other.mTexture;
+		mWidth = other.mWidth;
+		mHeight = other.mHeight;
+		other.mTexture = NULL;
+		other.mWidth = 0;
+		other.mHeight = 0;
+	}
+	return *this;
+}
+
 bool LTexture::loadFromFile(std::string path, SDL_Renderer* gRenderer)
 {
 	//get rid of preexisting texture
 	free();
 
+	//Pre-decoded pixels skip PNG decode and format conversion
+	SDL_Surface* cookedSurface = loadCookedTexture(cookedTexturePath(path));
+	if (cookedSurface != NULL)
+	{
+		bool cooked = loadFromSurface(cookedSurface, gRenderer);
+		SDL_FreeSurface(cookedSurface);
+		if (cooked)
+		{
+			return true;
+		}
+	}
+
 	//the final texture
 	SDL_Texture* newTexture = NULL;
 
@@ -63,6 +102,97 @@ bool LTexture::loadFromFile(std::string path, SDL_Renderer* gRenderer)
 	return mTexture != NULL;
 }
 
+bool LTexture::loadFromSurface(SDL_Surface* surface, SDL_Renderer* gRenderer)
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Surfaces already in a native format are uploaded as they are
+	if (surface->format->palette == NULL && !SDL_MUSTLOCK(surface) && !SDL_HasColorKey(surface) &&
+		loadFromPixels(surface->format->format, surface->w, surface->h, surface->pixels, surface->pitch, gRenderer))
+	{
+		if (surface->format->Amask != 0)
+		{
+			SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+		}
+		return true;
+	}
+
+	//Create texture from surface pixels
+	mTexture = SDL_CreateTextureFromSurface(gRenderer, surface);
+	if (mTexture == NULL)
+	{
+		printf("Unable to create texture from surface! SDL Error: %s\n", SDL_GetError());
+	}
+	else
+	{
+		//Get image dimensions
+		mWidth = surface->w;
+		mHeight = surface->h;
+	}
+
+	//Return success
+	return mTexture != NULL;
+}
+
+bool LTexture::loadFromCooked(const void* data, size_t size, SDL_Renderer* gRenderer)
+{
+	//Get rid of preexisting texture
+	free();
+
+	CookedTextureHeader header;
+	const void* pixels;
+	if (!parseCookedTexture(data, size, &header, &pixels))
+	{
+		printf("Invalid cooked texture data!\n");
+		return false;
+	}
+	if (!loadFromPixels(header.format, header.width, header.height, pixels, header.pitch, gRenderer))
+	{
+		printf("Unable to upload cooked texture! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+	return true;
+}
+
+bool LTexture::loadFromPixels(Uint32 format, int width, int height, const void* pixels, int pitch, SDL_Renderer* gRenderer)
+{
+	//Only take formats the renderer stores natively, anything else would be converted on upload
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(gRenderer, &info) != 0)
+	{
+		return false;
+	}
+	bool native = false;
+	for (Uint32 i = 0; i < info.num_texture_formats; i++)
+	{
+		if (info.texture_formats[i] == format)
+		{
+			native = true;
+		}
+	}
+	if (!native)
+	{
+		return false;
+	}
+
+	SDL_Texture* newTexture = SDL_CreateTexture(gRenderer, format, SDL_TEXTUREACCESS_STATIC, width, height);
+	if (newTexture == NULL)
+	{
+		return false;
+	}
+	if (SDL_UpdateTexture(newTexture, NULL, pixels, pitch) != 0)
+	{
+		SDL_DestroyTexture(newTexture);
+		return false;
+	}
+
+	mTexture = newTexture;
+	mWidth = width;
+	mHeight = height;
+	return true;
+}
+
 bool LTexture::loadFromRenderedText(std::string textureText, SDL_Color textColor, SDL_Color bgColor, TTF_Font* gFont, SDL_Renderer* gRenderer)
 {
 	//Get rid of preexisting texture
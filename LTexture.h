@@ -1,3 +1,5 @@
+#pragma once
+
 #include <SDL.h>
 #include <SDL_image.h>
 #include <stdio.h>
@@ -16,9 +18,23 @@ public:
 	//Deallocates memory, calls free
 	~LTexture();
 
-	//loads image at specific path
+	//Takes over another texture, which is left empty
+	LTexture(LTexture&& other);
+	LTexture& operator=(LTexture&& other);
+
+	//Copies would free the same texture twice
+	LTexture(const LTexture&) = delete;
+	LTexture& operator=(const LTexture&) = delete;
+
+	//loads image at specific path, a cooked file next to it is used instead when present
 	bool loadFromFile(std::string path, SDL_Renderer* gRenderer);
 
+	//Creates image from cooked texture bytes, uploaded without any conversion
+	bool loadFromCooked(const void* data, size_t size, SDL_Renderer* gRenderer);
+
+	//Creates image from an already decoded surface, surface stays owned by the caller
+	bool loadFromSurface(SDL_Surface* surface, SDL_Renderer* gRenderer);
+
 	//Creates image from font string
 	bool loadFromRenderedText(std::string textureText, SDL_Color textColor, SDL_Color bgColor, TTF_Font* gFont, SDL_Renderer* gRenderer);
 
@@ -39,4 +55,7 @@ private:
 	//Image dimensions
 	int mWidth;
 	int mHeight;
+
+	//Uploads pixels as they are, fails if the renderer can't take the format
+	bool loadFromPixels(Uint32 format, int width, int height, const void* pixels, int pitch, SDL_Renderer* gRenderer);
 };
@@ -0,0 +1,118 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "LatencyTracker.h"
+
+LatencyTracker::LatencyTracker()
+{
+	//initialize
+	mProfiler = NULL;
+	mSamples.resize(LATENCY_MAX_SAMPLES);
+	mTotal = 0;
+}
+
+void LatencyTracker::setProfiler(FrameProfiler* profiler)
+{
+	mProfiler = profiler;
+}
+
+LatencyClick LatencyTracker::begin(Uint32 eventTimestamp, Uint32 round, int state)
+{
+	LatencyClick click;
+	click.handledCounter = SDL_GetPerformanceCounter();
+	click.round = round;
+	click.state = state;
+
+	//Event timestamps are in SDL ticks, move it onto the counter by how long ago it was
+	Uint32 age = SDL_GetTicks() - eventTimestamp;
+	Uint64 ageCounts = (Uint64)age * SDL_GetPerformanceFrequency() / 1000;
+	click.eventCounter = ageCounts < click.handledCounter ? click.handledCounter - ageCounts : 0;
+	return click;
+}
+
+void LatencyTracker::end(const LatencyClick& click)
+{
+	Uint64 presented = SDL_GetPerformanceCounter();
+	double countsToMs = 1000.0 / SDL_GetPerformanceFrequency();
+
+	LatencySample& sample = mSamples[mTotal % LATENCY_MAX_SAMPLES];
+	sample.round = click.round;
+	sample.state = click.state;
+	sample.handleMs = (float)((click.handledCounter - click.eventCounter) * countsToMs);
+	sample.presentMs = (float)((presented - click.eventCounter) * countsToMs);
+	mTotal++;
+
+	//Shows up in the F3 overlay and the trace like any other section
+	if (mProfiler != NULL)
+	{
+		mProfiler->record(PROFILE_CLICK, click.eventCounter, presented);
+	}
+}
+
+int LatencyTracker::getSampleCount()
+{
+	return mTotal < LATENCY_MAX_SAMPLES ? (int)mTotal : LATENCY_MAX_SAMPLES;
+}
+
+const LatencySample& LatencyTracker::getSample(int index)
+{
+	long long first = mTotal - getSampleCount();
+	return mSamples[(first + index) % LATENCY_MAX_SAMPLES];
+}
+
+double LatencyTracker::getPercentile(double fraction)
+{
+	int count = getSampleCount();
+	if (count == 0)
+	{
+		return 0.0;
+	}
+
+	//Only run at the end, so a sorted copy is fine
+	std::vector<float> sorted(count);
+	for (int i = 0; i < count; i++)
+	{
+		sorted[i] = mSamples[i].presentMs;
+	}
+	int rank = (int)(fraction * (count - 1) + 0.5);
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+	return sorted[rank];
+}
+
+void LatencyTracker::printSummary()
+{
+	int count = getSampleCount();
+	if (count == 0)
+	{
+		return;
+	}
+
+	double handleTotal = 0.0;
+	for (int i = 0; i < count; i++)
+	{
+		handleTotal += mSamples[i].handleMs;
+	}
+	printf("Click to photon over %d clicks: p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms  (event to logic %.2f ms avg)\n",
+		count, getPercentile(0.50), getPercentile(0.95), getPercentile(0.99), getPercentile(1.0), handleTotal / count);
+}
+
+bool LatencyTracker::exportCsv(std::string path)
+{
+	FILE* file = fopen(path.c_str(), "w");
+	if (file == NULL)
+	{
+		printf("Unable to write %s\n", path.c_str());
+		return false;
+	}
+
+	fprintf(file, "round,state,handle_ms,present_ms\n");
+	for (int i = 0; i < getSampleCount(); i++)
+	{
+		const LatencySample& sample = getSample(i);
+		fprintf(file, "%u,%d,%.3f,%.3f\n", sample.round, sample.state, sample.handleMs, sample.presentMs);
+	}
+	fclose(file);
+	return true;
+}
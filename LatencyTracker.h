@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "FrameProfiler.h"
+
+//Samples kept for the summary and CSV, older ones are overwritten
+const int LATENCY_MAX_SAMPLES = 16384;
+
+//A click on its way to the screen, stamped by the logic thread
+struct LatencyClick
+{
+	//Mouse button release, converted to the performance counter
+	Uint64 eventCounter;
+
+	//When the game logic applied it
+	Uint64 handledCounter;
+
+	//Round and screen it led to
+	Uint32 round;
+	int state;
+};
+
+//One click's trip from SDL_MOUSEBUTTONUP to the present that showed its result
+struct LatencySample
+{
+	Uint32 round;
+	int state;
+	float handleMs;
+	float presentMs;
+};
+
+//Click-to-photon latency of every click that changed the screen
+//Clicks are stamped where they are handled and finished after the present that
+//shows them, "photon" being when SDL_RenderPresent returns
+class LatencyTracker
+{
+public:
+	//Initializes variables, the sample ring is allocated up front
+	LatencyTracker();
+
+	//Also records finished clicks into the profiler's click section, profiler may be NULL
+	void setProfiler(FrameProfiler* profiler);
+
+	//Stamps a click from its SDL event timestamp, call as soon as the logic has applied it
+	static LatencyClick begin(Uint32 eventTimestamp, Uint32 round, int state);
+
+	//Records a click whose result was just presented
+	void end(const LatencyClick& click);
+
+	//Gets number of samples kept
+	int getSampleCount();
+
+	//Gets a percentile of event to present milliseconds over the kept samples
+	double getPercentile(double fraction);
+
+	//Prints count, percentiles and worst case
+	void printSummary();
+
+	//Writes every kept sample, oldest first
+	bool exportCsv(std::string path);
+
+private:
+	//Gets a kept sample, 0 is the oldest
+	const LatencySample& getSample(int index);
+
+	FrameProfiler* mProfiler;
+
+	//Ring of the latest samples and how many were ever recorded
+	std::vector<LatencySample> mSamples;
+	long long mTotal;
+};
@@ -0,0 +1,76 @@
+#include <SDL.h>
+#include <string.h>
+#include "LocalSocket.h"
+
+LocalSocket::LocalSocket()
+{
+}
+
+LocalSocket::~LocalSocket()
+{
+	close();
+}
+
+void LocalSocket::connect(LocalSocket* a, LocalSocket* b)
+{
+	std::shared_ptr<Channel> aToB(new Channel);
+	std::shared_ptr<Channel> bToA(new Channel);
+	a->mOutgoing = aToB;
+	a->mIncoming = bToA;
+	b->mOutgoing = bToA;
+	b->mIncoming = aToB;
+}
+
+bool LocalSocket::send(const void* data, int size)
+{
+	if (!mOutgoing || mOutgoing->closed || size < 0)
+	{
+		return false;
+	}
+
+	const Uint8* bytes = (const Uint8*)data;
+	std::lock_guard<std::mutex> lock(mOutgoing->mutex);
+	mOutgoing->messages.push_back(std::vector<Uint8>(bytes, bytes + size));
+	return true;
+}
+
+int LocalSocket::receive(void* data, int capacity)
+{
+	if (!mIncoming)
+	{
+		return -1;
+	}
+
+	std::lock_guard<std::mutex> lock(mIncoming->mutex);
+	if (mIncoming->messages.empty())
+	{
+		return mIncoming->closed ? -1 : 0;
+	}
+
+	//Like a datagram, whatever does not fit is dropped
+	std::vector<Uint8>& message = mIncoming->messages.front();
+	int size = (int)message.size() < capacity ? (int)message.size() : capacity;
+	if (size > 0)
+	{
+		memcpy(data, &message[0], size);
+	}
+	mIncoming->messages.pop_front();
+	return size;
+}
+
+void LocalSocket::close()
+{
+	if (mOutgoing)
+	{
+		mOutgoing->closed = true;
+	}
+	if (mIncoming)
+	{
+		mIncoming->closed = true;
+	}
+}
+
+bool LocalSocket::isOpen()
+{
+	return mOutgoing && !mOutgoing->closed && mIncoming && !mIncoming->closed;
+}
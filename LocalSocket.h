@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL.h>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <atomic>
+
+//In-process stand-in for a datagram socket, every send arrives whole and in order at the peer
+//Safe to use from different threads on the two ends
+class LocalSocket
+{
+public:
+	//Initializes an unconnected socket
+	LocalSocket();
+
+	//Closes the socket
+	~LocalSocket();
+
+	//Joins two sockets so each receives what the other sends
+	static void connect(LocalSocket* a, LocalSocket* b);
+
+	//Queues a message for the peer, false if not connected or closed
+	bool send(const void* data, int size);
+
+	//Takes the next message up to capacity bytes
+	//Returns its size, 0 if nothing is waiting, -1 once the peer has closed and everything is read
+	int receive(void* data, int capacity);
+
+	//Closes both directions
+	void close();
+
+	//Checks whether the connection is still open
+	bool isOpen();
+
+private:
+	//One direction of a connection
+	struct Channel
+	{
+		std::mutex mutex;
+		std::deque< std::vector<Uint8> > messages;
+		std::atomic<bool> closed;
+
+		Channel() : closed(false) {}
+	};
+
+	std::shared_ptr<Channel> mIncoming;
+	std::shared_ptr<Channel> mOutgoing;
+};
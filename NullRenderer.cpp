@@ -0,0 +1,20 @@
+#include "NullRenderer.h"
+
+NullRenderer::NullRenderer()
+{
+	mFrameCount = 0;
+}
+
+void NullRenderer::renderFrame(const BoardMessage&)
+{
+	mFrameCount++;
+}
+
+void NullRenderer::invalidate()
+{
+}
+
+int NullRenderer::getFrameCount()
+{
+	return mFrameCount;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "IRenderer.h"
+
+//Renderer that draws nothing, for headless simulation
+class NullRenderer : public IRenderer
+{
+public:
+	//Initializes variables
+	NullRenderer();
+
+	//Counts the frame and nothing else
+	void renderFrame(const BoardMessage& board);
+	void invalidate();
+
+	//Gets number of frames requested
+	int getFrameCount();
+
+private:
+	//Frames requested so far
+	int mFrameCount;
+};
@@ -0,0 +1,88 @@
+#include <SDL.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include "ReactionStats.h"
+
+ReactionStats::ReactionStats()
+{
+	reset();
+}
+
+void ReactionStats::reset()
+{
+	mCount = 0;
+	mMean = 0.0;
+	mM2 = 0.0;
+	mMin = 0;
+	mMax = 0;
+}
+
+void ReactionStats::add(Uint64 micros)
+{
+	mRing[mCount % REACTION_RING_SIZE] = micros;
+	mCount++;
+
+	double delta = (double)micros - mMean;
+	mMean += delta / mCount;
+	mM2 += delta * ((double)micros - mMean);
+	if (mCount == 1 || micros < mMin)
+		mMin = micros;
+	if (mCount == 1 || micros > mMax)
+		mMax = micros;
+}
+
+int ReactionStats::getCount()
+{
+	return mCount;
+}
+
+double ReactionStats::getLastMs()
+{
+	return mCount > 0 ? mRing[(mCount - 1) % REACTION_RING_SIZE] / 1000.0 : 0.0;
+}
+
+double ReactionStats::getMeanMs()
+{
+	return mMean / 1000.0;
+}
+
+double ReactionStats::getStdDevMs()
+{
+	return mCount > 1 ? sqrt(mM2 / (mCount - 1)) / 1000.0 : 0.0;
+}
+
+double ReactionStats::getMinMs()
+{
+	return mMin / 1000.0;
+}
+
+double ReactionStats::getMaxMs()
+{
+	return mMax / 1000.0;
+}
+
+double ReactionStats::getPercentileMs(double fraction)
+{
+	int kept = SDL_min(mCount, REACTION_RING_SIZE);
+	if (kept == 0)
+	{
+		return 0.0;
+	}
+
+	//Selection on a copy, the ring keeps its order
+	std::copy(mRing, mRing + kept, mScratch);
+	int rank = (int)(fraction * (kept - 1) + 0.5);
+	std::nth_element(mScratch, mScratch + rank, mScratch + kept);
+	return mScratch[rank] / 1000.0;
+}
+
+void ReactionStats::printSummary()
+{
+	if (mCount == 0)
+	{
+		return;
+	}
+	printf("Reaction times over %d clicks: mean %.1f ms  sd %.1f ms  best %.1f ms  p50 %.1f ms  p90 %.1f ms  worst %.1f ms\n",
+		mCount, getMeanMs(), getStdDevMs(), getMinMs(), getPercentileMs(0.50), getPercentileMs(0.90), getMaxMs());
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL.h>
+
+//Reaction times kept for percentiles, more than the rounds of one game
+const int REACTION_RING_SIZE = 64;
+
+//Per-click reaction times of one game
+//Storage is fixed, nothing is allocated while playing
+//Mean and variance stream over every click, percentiles use the latest REACTION_RING_SIZE
+class ReactionStats
+{
+public:
+	//Initializes empty stats
+	ReactionStats();
+
+	//Forgets every click
+	void reset();
+
+	//Adds the time from a round appearing to the click on it
+	void add(Uint64 micros);
+
+	//Gets number of clicks added since reset
+	int getCount();
+
+	//Gets stats in milliseconds, 0 without clicks
+	double getLastMs();
+	double getMeanMs();
+	double getStdDevMs();
+	double getMinMs();
+	double getMaxMs();
+	double getPercentileMs(double fraction);
+
+	//Prints an end of game summary
+	void printSummary();
+
+private:
+	//Latest reaction times, mCount says how many were ever added
+	Uint64 mRing[REACTION_RING_SIZE];
+	int mCount;
+
+	//Welford's running mean and sum of squared differences, in microseconds
+	double mMean;
+	double mM2;
+	Uint64 mMin;
+	Uint64 mMax;
+
+	//Work space for percentiles
+	Uint64 mScratch[REACTION_RING_SIZE];
+};
@@ -0,0 +1,135 @@
+#include <SDL.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include "RenderQueue.h"
+
+RenderQueue::RenderQueue()
+{
+	//initialize
+	for (int i = 0; i < 2; i++)
+	{
+		mFrames[i].state = INTRO_SCREEN;
+		memset(&mFrames[i].board, 0, sizeof(BoardMessage));
+		resetCommands(&mFrames[i]);
+	}
+	mRecording = 0;
+	mSubmitted = -1;
+	mWake = SDL_CreateSemaphore(0);
+	mRetryWanted = false;
+	mEventType = (Uint32)-1;
+	mScaleX = 1.0f;
+	mScaleY = 1.0f;
+	mScalePublished = false;
+}
+
+RenderQueue::~RenderQueue()
+{
+	if (mWake != NULL)
+	{
+		SDL_DestroySemaphore(mWake);
+		mWake = NULL;
+	}
+}
+
+RenderFrame* RenderQueue::record()
+{
+	return &mFrames[mRecording];
+}
+
+bool RenderQueue::submit()
+{
+	//Event type can only be registered once SDL is up
+	if (mEventType == (Uint32)-1)
+	{
+		mEventType = SDL_RegisterEvents(1);
+	}
+
+	//Ask for the retry event before looking, so a release right after the check still sends it
+	mRetryWanted.store(true);
+	if (mSubmitted.load() != -1)
+	{
+		return false;
+	}
+	mRetryWanted.store(false, std::memory_order_relaxed);
+
+	//Publish the recording, the other buffer was released and is free to reuse
+	mSubmitted.store(mRecording, std::memory_order_release);
+	mRecording ^= 1;
+	resetCommands(&mFrames[mRecording]);
+	wake();
+	return true;
+}
+
+RenderFrame* RenderQueue::acquire(Uint32 timeout)
+{
+	//Sleep only if nothing is waiting, otherwise just take the wake up that came with it
+	int submitted = mSubmitted.load(std::memory_order_acquire);
+	if (mWake != NULL)
+	{
+		SDL_SemWaitTimeout(mWake, submitted == -1 ? timeout : 0);
+	}
+	if (submitted == -1)
+	{
+		submitted = mSubmitted.load(std::memory_order_acquire);
+	}
+	return submitted != -1 ? &mFrames[submitted] : NULL;
+}
+
+void RenderQueue::release()
+{
+	mSubmitted.store(-1);
+
+	//Wake the main loop so it can submit what it recorded meanwhile
+	if (mRetryWanted.exchange(false) && mEventType != (Uint32)-1)
+	{
+		SDL_Event e;
+		SDL_memset(&e, 0, sizeof(e));
+		e.type = mEventType;
+		SDL_PushEvent(&e);
+	}
+}
+
+Uint32 RenderQueue::getEventType()
+{
+	return mEventType;
+}
+
+void RenderQueue::wake()
+{
+	if (mWake != NULL)
+	{
+		SDL_SemPost(mWake);
+	}
+}
+
+void RenderQueue::publishScale(float scaleX, float scaleY)
+{
+	std::lock_guard<std::mutex> lock(mScaleMutex);
+	mScaleX = scaleX;
+	mScaleY = scaleY;
+	mScalePublished.store(true, std::memory_order_release);
+}
+
+bool RenderQueue::takeScale(float* scaleX, float* scaleY)
+{
+	//Checked every frame, so the lock is only taken after a publish
+	if (!mScalePublished.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(mScaleMutex);
+	*scaleX = mScaleX;
+	*scaleY = mScaleY;
+	mScalePublished.store(false, std::memory_order_relaxed);
+	return true;
+}
+
+void RenderQueue::resetCommands(RenderFrame* frame)
+{
+	frame->eventCount = 0;
+	frame->invalidate = false;
+	frame->toggleOverlay = false;
+	frame->exportTrace = false;
+	frame->clickCount = 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <mutex>
+#include "GameSession.h"
+#include "LatencyTracker.h"
+
+//Window and device events forwarded per frame, more mark the whole frame dirty
+const int RENDER_MAX_EVENTS = 16;
+
+//Clicks timed per frame, more in one frame go unmeasured
+const int RENDER_MAX_CLICKS = 8;
+
+//Everything the render thread needs to draw one frame, recorded by the logic thread
+//Commands that repeat before the render thread takes the frame collapse into one
+struct RenderFrame
+{
+	//Screen and board to draw
+	int state;
+	BoardMessage board;
+
+	//Window and device events for the layout and the retained scene
+	int eventCount;
+	SDL_Event events[RENDER_MAX_EVENTS];
+	bool invalidate;
+
+	//Profiler overlay toggles and trace export
+	bool toggleOverlay;
+	bool exportTrace;
+
+	//Clicks whose result this frame shows, timed once it is presented
+	int clickCount;
+	LatencyClick clicks[RENDER_MAX_CLICKS];
+};
+
+//Double-buffered handoff of frames from the logic thread to the render thread
+//Neither side waits on the other: one buffer is recorded while the other is handed
+//over, and a frame the render thread has not taken yet keeps recording
+//Pixels per window point go back the other way, under a lock that is only taken when they are published
+class RenderQueue
+{
+public:
+	//Initializes variables
+	RenderQueue();
+
+	//Frees the wake semaphore
+	~RenderQueue();
+
+	//Logic thread: gets the frame being recorded
+	RenderFrame* record();
+
+	//Logic thread: hands the recorded frame over and starts a fresh one
+	//Returns false if the render thread has not taken the last frame yet, recording then carries on
+	//and an event of getEventType is pushed once it is taken, so an idle main loop knows to submit again
+	bool submit();
+
+	//Gets the event type pushed when a frame that blocked a submit is released
+	Uint32 getEventType();
+
+	//Render thread: waits up to timeout milliseconds for a handed over frame, NULL if none came
+	RenderFrame* acquire(Uint32 timeout);
+
+	//Render thread: gives the acquired frame back
+	void release();
+
+	//Wakes a render thread waiting in acquire
+	void wake();
+
+	//Render thread: hands the renderer's pixels per window point to hit testing
+	void publishScale(float scaleX, float scaleY);
+
+	//Logic thread: gets the newest scale, returns false if none was published since the last call
+	bool takeScale(float* scaleX, float* scaleY);
+
+private:
+	//Clears commands of the frame about to be recorded
+	void resetCommands(RenderFrame* frame);
+
+	RenderFrame mFrames[2];
+
+	//Buffer the logic thread records into, only touched by it
+	int mRecording;
+
+	//Buffer handed over and not yet released, -1 if none
+	std::atomic<int> mSubmitted;
+
+	//Lets an idle render thread sleep instead of spinning
+	SDL_sem* mWake;
+
+	//Set by a submit that found the last frame still handed over, the release then pushes mEventType
+	std::atomic<bool> mRetryWanted;
+	Uint32 mEventType;
+
+	//Scale published by the render thread
+	std::mutex mScaleMutex;
+	float mScaleX;
+	float mScaleY;
+	std::atomic<bool> mScalePublished;
+};
@@ -0,0 +1,151 @@
+#include <SDL.h>
+#include <stdio.h>
+#include "RetainedScene.h"
+
+RetainedScene::RetainedScene()
+{
+	//initialize
+	mTarget = NULL;
+	mTargetWidth = 0;
+	mTargetHeight = 0;
+	mDirtyLayers = SCENE_ALL;
+	mDirtyRect.x = 0;
+	mDirtyRect.y = 0;
+	mDirtyRect.w = 0;
+	mDirtyRect.h = 0;
+	mDirtyAll = true;
+}
+
+RetainedScene::~RetainedScene()
+{
+	//Deallocates memory, calls free
+	free();
+}
+
+void RetainedScene::markDirty(int layers, const SDL_Rect* region)
+{
+	//No region means the whole frame
+	if (region == NULL)
+	{
+		mDirtyAll = true;
+	}
+	else if (mDirtyLayers == 0)
+	{
+		mDirtyRect = *region;
+	}
+	else
+	{
+		//Grow dirty box to cover the new region
+		int x1 = SDL_min(mDirtyRect.x, region->x);
+		int y1 = SDL_min(mDirtyRect.y, region->y);
+		int x2 = SDL_max(mDirtyRect.x + mDirtyRect.w, region->x + region->w);
+		int y2 = SDL_max(mDirtyRect.y + mDirtyRect.h, region->y + region->h);
+		mDirtyRect.x = x1;
+		mDirtyRect.y = y1;
+		mDirtyRect.w = x2 - x1;
+		mDirtyRect.h = y2 - y1;
+	}
+	mDirtyLayers |= layers;
+}
+
+bool RetainedScene::isDirty(int layers)
+{
+	return (mDirtyLayers & layers) != 0;
+}
+
+SDL_Rect RetainedScene::getDirtyRect()
+{
+	if (mDirtyAll)
+	{
+		SDL_Rect all = { 0, 0, mTargetWidth, mTargetHeight };
+		return all;
+	}
+	return mDirtyRect;
+}
+
+void RetainedScene::handleEvent(SDL_Event* e)
+{
+	if (e->type == SDL_WINDOWEVENT)
+	{
+		if (e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED || e->window.event == SDL_WINDOWEVENT_EXPOSED)
+		{
+			markDirty(SCENE_ALL);
+		}
+	}
+	//Target contents are gone after a device reset
+	else if (e->type == SDL_RENDER_TARGETS_RESET || e->type == SDL_RENDER_DEVICE_RESET)
+	{
+		markDirty(SCENE_ALL);
+	}
+}
+
+bool RetainedScene::updateTarget(SDL_Renderer* gRenderer)
+{
+	int width, height;
+	SDL_GetRendererOutputSize(gRenderer, &width, &height);
+	if (mTarget != NULL && width == mTargetWidth && height == mTargetHeight)
+	{
+		return true;
+	}
+
+	free();
+	mTargetWidth = width;
+	mTargetHeight = height;
+
+	//Without a target every dirty frame is drawn from scratch
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(gRenderer, &info) == 0 && (info.flags & SDL_RENDERER_TARGETTEXTURE))
+	{
+		mTarget = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+		if (mTarget == NULL)
+		{
+			printf("Unable to create retained frame! SDL Error: %s\n", SDL_GetError());
+		}
+		else
+		{
+			//Copied over an undefined back buffer, so the frame must replace it, not blend with it
+			SDL_SetTextureBlendMode(mTarget, SDL_BLENDMODE_NONE);
+		}
+	}
+
+	//New target has no contents yet
+	mDirtyAll = true;
+	mDirtyLayers = SCENE_ALL;
+	return mTarget != NULL;
+}
+
+void RetainedScene::beginFrame(SDL_Renderer* gRenderer)
+{
+	if (!updateTarget(gRenderer))
+	{
+		//Back buffer is undefined after present, redraw everything
+		mDirtyAll = true;
+		mDirtyLayers = SCENE_ALL;
+		return;
+	}
+	SDL_SetRenderTarget(gRenderer, mTarget);
+}
+
+void RetainedScene::present(SDL_Renderer* gRenderer)
+{
+	if (mTarget != NULL)
+	{
+		SDL_SetRenderTarget(gRenderer, NULL);
+		SDL_RenderCopy(gRenderer, mTarget, NULL, NULL);
+	}
+	SDL_RenderPresent(gRenderer);
+
+	//Everything is up to date
+	mDirtyLayers = 0;
+	mDirtyAll = false;
+}
+
+//Deallocates retained frame
+void RetainedScene::free()
+{
+	if (mTarget != NULL)
+	{
+		SDL_DestroyTexture(mTarget);
+		mTarget = NULL;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SDL.h>
+
+//Layers of the in-game frame that can be invalidated separately
+enum SceneLayer
+{
+	SCENE_BOARD = 1,
+	SCENE_HUD = 2,
+	SCENE_ALL = SCENE_BOARD | SCENE_HUD
+};
+
+//Keeps the last frame in a render target and only redraws invalidated layers
+class RetainedScene
+{
+public:
+	//Initializes variables
+	RetainedScene();
+
+	//Deallocates memory, calls free
+	~RetainedScene();
+
+	//Marks layers dirty, optionally only over part of the frame
+	void markDirty(int layers, const SDL_Rect* region = NULL);
+
+	//Checks if any of the layers needs drawing
+	bool isDirty(int layers = SCENE_ALL);
+
+	//Gets the bounding box of everything dirty
+	SDL_Rect getDirtyRect();
+
+	//Invalidates the frame on resize, expose and lost render targets
+	void handleEvent(SDL_Event* e);
+
+	//Redirects drawing into the retained frame
+	void beginFrame(SDL_Renderer* gRenderer);
+
+	//Shows the retained frame and clears dirty state
+	void present(SDL_Renderer* gRenderer);
+
+	//Deallocates retained frame
+	void free();
+
+private:
+	//Makes sure the retained frame matches the output size
+	bool updateTarget(SDL_Renderer* gRenderer);
+
+	//The retained frame, NULL if render targets are unsupported
+	SDL_Texture* mTarget;
+	int mTargetWidth;
+	int mTargetHeight;
+
+	//Dirty layers and their bounding box
+	int mDirtyLayers;
+	SDL_Rect mDirtyRect;
+	bool mDirtyAll;
+};
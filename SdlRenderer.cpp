@@ -0,0 +1,105 @@
+#include <SDL.h>
+#include "SdlRenderer.h"
+
+//Score position in the HUD strip, in window points
+const int HUD_SCORE_X = 150;
+
+SdlRenderer::SdlRenderer(SDL_Renderer* gRenderer, BoardLayout* layout, GridRenderer* grid, RetainedScene* scene, HudLabel* timeLabel, HudLabel* scoreLabel)
+{
+	mRenderer = gRenderer;
+	mLayout = layout;
+	mGrid = grid;
+	mScene = scene;
+	mTimeLabel = timeLabel;
+	mScoreLabel = scoreLabel;
+	mProfiler = NULL;
+	mDeficiency = VISION_NORMAL;
+	mDrawnRound = -1;
+}
+
+void SdlRenderer::setProfiler(FrameProfiler* profiler)
+{
+	mProfiler = profiler;
+}
+
+void SdlRenderer::setDeficiency(ColorDeficiency deficiency)
+{
+	mDeficiency = deficiency;
+	invalidate();
+}
+
+void SdlRenderer::invalidate()
+{
+	mScene->markDirty(SCENE_ALL);
+}
+
+void SdlRenderer::renderFrame(const BoardMessage& board)
+{
+	//Board is only dirty when a new round started
+	if ((int)board.round != mDrawnRound)
+	{
+		mDrawnRound = (int)board.round;
+		mScene->markDirty(SCENE_BOARD);
+	}
+
+	//HUD is only dirty when a label's value changes
+	SDL_Rect hudRect = mLayout->getHudRect();
+	{
+		ProfileScope hudScope(mProfiler, PROFILE_HUD);
+		if (mTimeLabel->setValue(board.elapsedSeconds, mRenderer))
+		{
+			mScene->markDirty(SCENE_HUD, &hudRect);
+		}
+		if (mScoreLabel->setValue(board.score, mRenderer))
+		{
+			mScene->markDirty(SCENE_HUD, &hudRect);
+		}
+	}
+
+	//Overlay sits on top of the board, so a new overlay redraws everything
+	if (mProfiler != NULL && mProfiler->refreshOverlay(mRenderer))
+	{
+		mScene->markDirty(SCENE_ALL);
+	}
+
+	//Nothing changed, keep the last frame on screen
+	if (!mScene->isDirty())
+	{
+		return;
+	}
+
+	mScene->beginFrame(mRenderer);
+	if (mScene->isDirty(SCENE_BOARD))
+	{
+		ProfileScope boardScope(mProfiler, PROFILE_BOARD);
+
+		//Clear screen
+		SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+		SDL_RenderClear(mRenderer);
+
+		//Whole board is one batch, rebuilt only when something changed
+		mGrid->setColors(simulateDeficiency(board.baseColor, mDeficiency), simulateDeficiency(board.oddColor, mDeficiency), board.oddCell);
+		mGrid->render(mRenderer);
+	}
+	else
+	{
+		//Only clear the HUD strip
+		SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+		SDL_RenderFillRect(mRenderer, &hudRect);
+	}
+
+	//render score and time
+	{
+		ProfileScope hudScope(mProfiler, PROFILE_HUD);
+		mTimeLabel->render(hudRect.x, hudRect.y, mRenderer);
+		mScoreLabel->render(hudRect.x + (int)(HUD_SCORE_X * mLayout->getScaleX()), hudRect.y, mRenderer);
+	}
+
+	if (mProfiler != NULL)
+	{
+		mProfiler->renderOverlay(0, 0, mRenderer);
+	}
+
+	ProfileScope presentScope(mProfiler, PROFILE_PRESENT);
+	mScene->present(mRenderer);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL.h>
+#include "IRenderer.h"
+#include "BoardLayout.h"
+#include "GridRenderer.h"
+#include "RetainedScene.h"
+#include "HudLabel.h"
+#include "FrameProfiler.h"
+#include "ColorVision.h"
+
+//Draws the in-game frame through SDL, redrawing only what changed
+class SdlRenderer : public IRenderer
+{
+public:
+	//Initializes variables, all objects stay owned by the caller
+	SdlRenderer(SDL_Renderer* gRenderer, BoardLayout* layout, GridRenderer* grid, RetainedScene* scene, HudLabel* timeLabel, HudLabel* scoreLabel);
+
+	//Draws board and HUD, presents only if something changed
+	void renderFrame(const BoardMessage& board);
+	void invalidate();
+
+	//Times frame sections and draws the profiler overlay, profiler may be NULL
+	void setProfiler(FrameProfiler* profiler);
+
+	//Shows board colors as seen with a color vision deficiency
+	void setDeficiency(ColorDeficiency deficiency);
+
+private:
+	//Targets and helpers
+	SDL_Renderer* mRenderer;
+	BoardLayout* mLayout;
+	GridRenderer* mGrid;
+	RetainedScene* mScene;
+	HudLabel* mTimeLabel;
+	HudLabel* mScoreLabel;
+
+	//Optional profiler
+	FrameProfiler* mProfiler;
+
+	//Simulated color vision
+	ColorDeficiency mDeficiency;
+
+	//Round currently on screen
+	int mDrawnRound;
+};
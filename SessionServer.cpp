@@ -0,0 +1,137 @@
+#include <SDL.h>
+#include <vector>
+#include "SessionServer.h"
+
+SessionServer::SessionServer(int threadCount, const DifficultyTable* table)
+	: mPool(threadCount)
+{
+	mTable = table;
+	mShards.resize(mPool.getThreadCount() * SESSION_SHARDS_PER_THREAD);
+	mSessionCount = 0;
+	mRoundsServed = 0;
+	mMessagesSent = 0;
+}
+
+SessionServer::~SessionServer()
+{
+	mPool.wait();
+	for (int i = 0; i < (int)mShards.size(); i++)
+	{
+		for (int j = 0; j < (int)mShards[i].size(); j++)
+		{
+			mShards[i][j]->serverSocket.close();
+			delete mShards[i][j]->session;
+			delete mShards[i][j];
+		}
+	}
+}
+
+LocalSocket* SessionServer::connect(int columns, int rows, Uint64 seed)
+{
+	Slot* slot = new Slot;
+	slot->session = new GameSession(mSessionCount, columns, rows, seed, mTable);
+	slot->lastRound = -1;
+	slot->lastState = -1;
+	LocalSocket::connect(&slot->serverSocket, &slot->clientSocket);
+
+	mShards[mSessionCount % mShards.size()].push_back(slot);
+	mSessionCount++;
+	return &slot->clientSocket;
+}
+
+void SessionServer::tick(Uint64 micros)
+{
+	for (int i = 0; i < (int)mShards.size(); i++)
+	{
+		if (!mShards[i].empty())
+		{
+			mPool.submit([this, i, micros]()
+			{
+				tickShard(i, micros);
+			});
+		}
+	}
+	mPool.wait();
+}
+
+void SessionServer::tickShard(int shard, Uint64 micros)
+{
+	long long rounds = 0;
+	long long messages = 0;
+	std::vector<Slot*>& slots = mShards[shard];
+	for (int i = 0; i < (int)slots.size(); i++)
+	{
+		Slot* slot = slots[i];
+		GameSession* session = slot->session;
+		if (session->getState() == QUIT_GAME)
+		{
+			continue;
+		}
+		session->step(micros);
+
+		//Apply every click that arrived since the last tick
+		ClickMessage click;
+		int size;
+		while ((size = slot->serverSocket.receive(&click, sizeof(click))) > 0)
+		{
+			if (size == sizeof(click))
+			{
+				session->click(click.cell, micros);
+			}
+		}
+		if (size < 0)
+		{
+			//Player hung up
+			session->quit();
+			slot->serverSocket.close();
+			continue;
+		}
+
+		//Only talk when there is something new to show
+		int round = session->getEngine().getRound();
+		if (round != slot->lastRound || session->getState() != slot->lastState)
+		{
+			if (round != slot->lastRound)
+			{
+				rounds++;
+			}
+			slot->lastRound = round;
+			slot->lastState = session->getState();
+
+			BoardMessage board;
+			session->writeBoard(&board);
+			if (slot->serverSocket.send(&board, sizeof(board)))
+			{
+				messages++;
+			}
+		}
+	}
+
+	mRoundsServed += rounds;
+	mMessagesSent += messages;
+}
+
+int SessionServer::getSessionCount()
+{
+	return mSessionCount;
+}
+
+int SessionServer::getThreadCount()
+{
+	return mPool.getThreadCount();
+}
+
+int SessionServer::getShardCount()
+{
+	return (int)mShards.size();
+}
+
+long long SessionServer::getRoundsServed()
+{
+	return mRoundsServed;
+}
+
+long long SessionServer::getMessagesSent()
+{
+	return mMessagesSent;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include <atomic>
+#include "GameSession.h"
+#include "LocalSocket.h"
+#include "WorkStealingPool.h"
+#include "DifficultyTable.h"
+
+//Shards handed to each pool thread per tick, more than one so busy shards can be stolen
+const int SESSION_SHARDS_PER_THREAD = 4;
+
+//Runs many game sessions in one process
+//Players talk to their session over a LocalSocket: ClickMessage in, BoardMessage out
+//Sessions are split into shards and each tick runs every shard on the thread pool,
+//so one session is only ever touched by one thread at a time
+class SessionServer
+{
+public:
+	//Starts the pool, 0 threads uses one per core, table may be NULL and must outlive the server
+	SessionServer(int threadCount, const DifficultyTable* table);
+
+	//Closes every connection and frees the sessions
+	~SessionServer();
+
+	//Creates a session on the intro screen and returns the player's end of its socket
+	//The socket belongs to the server, must not be called while tick is running
+	LocalSocket* connect(int columns, int rows, Uint64 seed);
+
+	//Applies every waiting click at the given time in microseconds and sends a board to each session whose round or screen changed
+	void tick(Uint64 micros);
+
+	//Gets counters
+	int getSessionCount();
+	int getThreadCount();
+	int getShardCount();
+	long long getRoundsServed();
+	long long getMessagesSent();
+
+private:
+	//One session with both ends of its connection and what its player last saw
+	struct Slot
+	{
+		GameSession* session;
+		LocalSocket serverSocket;
+		LocalSocket clientSocket;
+		int lastRound;
+		int lastState;
+	};
+
+	//Runs one shard for a tick
+	void tickShard(int shard, Uint64 micros);
+
+	WorkStealingPool mPool;
+	const DifficultyTable* mTable;
+	std::vector< std::vector<Slot*> > mShards;
+	int mSessionCount;
+
+	std::atomic<long long> mRoundsServed;
+	std::atomic<long long> mMessagesSent;
+};
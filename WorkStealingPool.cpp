@@ -0,0 +1,147 @@
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency();
+		if (threadCount <= 0)
+			threadCount = 1;
+	}
+
+	mPending = 0;
+	mQueued = 0;
+	mNextQueue = 0;
+	mStopping = false;
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		mQueues.push_back(new WorkerQueue());
+	}
+	for (int i = 0; i < threadCount; i++)
+	{
+		mThreads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	wait();
+
+	//Wake everyone up so they see the stop flag
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		mStopping = true;
+	}
+	mWake.notify_all();
+	for (int i = 0; i < (int)mThreads.size(); i++)
+	{
+		mThreads[i].join();
+	}
+	for (int i = 0; i < (int)mQueues.size(); i++)
+	{
+		delete mQueues[i];
+	}
+}
+
+void WorkStealingPool::submit(std::function<void()> task)
+{
+	mPending++;
+	WorkerQueue* queue = mQueues[mNextQueue++ % mQueues.size()];
+	{
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		queue->tasks.push_back(task);
+	}
+	mQueued++;
+
+	//Lock so a worker about to sleep cannot miss the notification
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+	}
+	mWake.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+	std::unique_lock<std::mutex> lock(mWakeMutex);
+	while (mPending > 0)
+	{
+		mIdle.wait(lock);
+	}
+}
+
+int WorkStealingPool::getThreadCount()
+{
+	return (int)mThreads.size();
+}
+
+bool WorkStealingPool::takeTask(int index, std::function<void()>& task)
+{
+	//Newest own task first, it is most likely still in cache
+	{
+		WorkerQueue* own = mQueues[index];
+		std::lock_guard<std::mutex> lock(own->mutex);
+		if (!own->tasks.empty())
+		{
+			task = own->tasks.back();
+			own->tasks.pop_back();
+			mQueued--;
+			return true;
+		}
+	}
+
+	//Steal the oldest task of another worker
+	for (int i = 1; i < (int)mQueues.size(); i++)
+	{
+		WorkerQueue* victim = mQueues[(index + i) % mQueues.size()];
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		if (!victim->tasks.empty())
+		{
+			task = victim->tasks.front();
+			victim->tasks.pop_front();
+			mQueued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+	std::function<void()> task;
+	while (true)
+	{
+		if (takeTask(index, task))
+		{
+			task();
+			task = nullptr;
+
+			//Last task done, release waiters
+			if (--mPending == 0)
+			{
+				std::lock_guard<std::mutex> lock(mWakeMutex);
+				mIdle.notify_all();
+			}
+			continue;
+		}
+
+		//Nothing anywhere, sleep until new work or shutdown
+		std::unique_lock<std::mutex> lock(mWakeMutex);
+		if (mStopping)
+		{
+			return;
+		}
+		mWake.wait(lock, [this] { return mStopping || mQueued > 0; });
+		if (mStopping && mQueued == 0)
+		{
+			return;
+		}
+	}
+}
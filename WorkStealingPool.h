@@ -0,0 +1,57 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//Thread pool where idle workers steal queued tasks from busy ones
+class WorkStealingPool
+{
+public:
+	//Starts worker threads, 0 uses one per core
+	WorkStealingPool(int threadCount = 0);
+
+	//Waits for queued tasks and joins workers
+	~WorkStealingPool();
+
+	//Queues a task, spread round robin over the workers
+	void submit(std::function<void()> task);
+
+	//Blocks until every submitted task has finished
+	void wait();
+
+	//Gets number of worker threads
+	int getThreadCount();
+
+private:
+	//One queue per worker, owner pops the back, thieves take the front
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque< std::function<void()> > tasks;
+	};
+
+	//Worker thread body
+	void workerLoop(int index);
+
+	//Takes a task from the own queue or steals one
+	bool takeTask(int index, std::function<void()>& task);
+
+	std::vector<WorkerQueue*> mQueues;
+	std::vector<std::thread> mThreads;
+
+	//Sleeping workers and waiters park here
+	std::mutex mWakeMutex;
+	std::condition_variable mWake;
+	std::condition_variable mIdle;
+
+	//Tasks submitted but not finished, and tasks still waiting in a queue
+	std::atomic<int> mPending;
+	std::atomic<int> mQueued;
+	std::atomic<unsigned int> mNextQueue;
+	std::atomic<bool> mStopping;
+};
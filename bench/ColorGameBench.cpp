@@ -0,0 +1,376 @@
+/*
+Color Game microbenchmarks
+Runs under SDL's dummy video driver with a software renderer so results
+are reproducible on headless machines. Prints a table and writes JSON
+that can be diffed between releases.
+
+Usage: bench [output.json] [asset directory]
+*/
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include "../LTexture.h"
+#include "../GlyphAtlas.h"
+#include "../HudLabel.h"
+#include "../BoardLayout.h"
+#include "../GridRenderer.h"
+#include "../GridHitTest.h"
+#include "../RetainedScene.h"
+#include "../ColorGameEngine.h"
+#include "../GameRng.h"
+#include "../ColorScience.h"
+#include "../DifficultyTable.h"
+#include "../ColorVision.h"
+#include "../SdlRenderer.h"
+#include "../GameSession.h"
+
+//Offscreen target size, same as the game window
+const int BENCH_WIDTH = 640;
+const int BENCH_HEIGHT = 510;
+
+//Minimum measuring time per benchmark
+const double BENCH_MIN_SECONDS = 0.25;
+
+//One benchmark result
+struct BenchResult
+{
+	std::string name;
+	long long iterations;
+	double nsPerOp;
+	bool skipped;
+};
+
+std::vector<BenchResult> gResults;
+
+//Runs body with growing iteration counts until it runs long enough
+void runBenchmark(std::string name, std::function<void()> body)
+{
+	long long iterations = 1;
+	double seconds = 0.0;
+	while (true)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (long long i = 0; i < iterations; i++)
+		{
+			body();
+		}
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (seconds >= BENCH_MIN_SECONDS || iterations >= (1LL << 40))
+			break;
+		iterations *= seconds > 0.01 ? (long long)(BENCH_MIN_SECONDS / seconds) + 1 : 10;
+	}
+
+	BenchResult result = { name, iterations, seconds * 1e9 / iterations, false };
+	gResults.push_back(result);
+	printf("%-40s %12lld %14.1f ns/op\n", name.c_str(), iterations, result.nsPerOp);
+}
+
+//Records a benchmark that could not run
+void skipBenchmark(std::string name, std::string reason)
+{
+	BenchResult result = { name, 0, 0.0, true };
+	gResults.push_back(result);
+	printf("%-40s skipped: %s\n", name.c_str(), reason.c_str());
+}
+
+//Writes results as JSON
+bool writeJson(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL)
+	{
+		printf("Unable to write %s\n", path);
+		return false;
+	}
+
+	fprintf(file, "{\n  \"context\": { \"video_driver\": \"dummy\", \"renderer\": \"software\", \"width\": %d, \"height\": %d },\n", BENCH_WIDTH, BENCH_HEIGHT);
+	fprintf(file, "  \"benchmarks\": [\n");
+	for (int i = 0; i < (int)gResults.size(); i++)
+	{
+		BenchResult& result = gResults[i];
+		fprintf(file, "    { \"name\": \"%s\", \"iterations\": %lld, \"ns_per_op\": %.3f, \"skipped\": %s }%s\n",
+			result.name.c_str(), result.iterations, result.nsPerOp, result.skipped ? "true" : "false",
+			i + 1 < (int)gResults.size() ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+	fclose(file);
+	return true;
+}
+
+int main(int argc, char* args[])
+{
+	const char* jsonPath = argc > 1 ? args[1] : "bench_results.json";
+	std::string assetDir = argc > 2 ? std::string(args[2]) + "/" : "";
+
+	//Headless and reproducible
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		return 1;
+	}
+	IMG_Init(IMG_INIT_PNG);
+	TTF_Init();
+
+	SDL_Surface* target = SDL_CreateRGBSurface(0, BENCH_WIDTH, BENCH_HEIGHT, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	SDL_Renderer* renderer = target != NULL ? SDL_CreateSoftwareRenderer(target) : NULL;
+	if (renderer == NULL)
+	{
+		printf("Software renderer could not be created! SDL Error: %s\n", SDL_GetError());
+		return 1;
+	}
+
+	SDL_Color textColor = { 0, 0, 0, 255 };
+	SDL_Color bgColor = { 255, 255, 255, 255 };
+	TTF_Font* font = TTF_OpenFont((assetDir + "WeLoveCuteThings.ttf").c_str(), 36);
+
+	printf("%-40s %12s %17s\n", "Benchmark", "Iterations", "Time");
+
+	//Text paths
+	LTexture texture;
+	if (font != NULL)
+	{
+		runBenchmark("LTexture_loadFromRenderedText", [&]()
+		{
+			texture.loadFromRenderedText("Score: 12", textColor, bgColor, font, renderer);
+		});
+	}
+	else
+	{
+		skipBenchmark("LTexture_loadFromRenderedText", "font not found");
+	}
+
+	std::string introPath = assetDir + "img/colorgame_intro_screen.png";
+	if (texture.loadFromFile(introPath, renderer))
+	{
+		runBenchmark("LTexture_loadFromFile", [&]()
+		{
+			texture.loadFromFile(introPath, renderer);
+		});
+	}
+	else
+	{
+		skipBenchmark("LTexture_loadFromFile", "intro screen not found");
+	}
+	texture.free();
+
+	GlyphAtlas atlas;
+	if (font != NULL && atlas.loadFromFont(font, textColor, bgColor, renderer))
+	{
+		runBenchmark("GlyphAtlas_render", [&]()
+		{
+			atlas.render("Time: 42", 0, 480, renderer);
+		});
+	}
+	else
+	{
+		skipBenchmark("GlyphAtlas_render", "font not found");
+	}
+
+	//Board drawing and hit testing at several sizes
+	int gridSizes[] = { 3, 32, MAX_GRID_SIZE };
+	for (int i = 0; i < 3; i++)
+	{
+		int size = gridSizes[i];
+		std::string suffix = "/" + std::to_string(size) + "x" + std::to_string(size);
+
+		BoardLayout layout;
+		layout.setGrid(size, size);
+		layout.setHudHeight(30);
+		SDL_Rect board = { 0, 0, BENCH_WIDTH, BENCH_HEIGHT - 30 };
+
+		GridRenderer grid;
+		GridHitTest hitTest;
+		hitTest.setUniformGrid(board, size, size);
+
+		std::vector<SDL_Rect> cells;
+		for (int cell = 0; cell < size * size; cell++)
+		{
+			SDL_Rect rect = { board.w * (cell % size) / size, board.h * (cell / size) / size, board.w / size, board.h / size };
+			cells.push_back(rect);
+		}
+
+		SDL_Color baseColor = { 40, 200, 120, 255 };
+		SDL_Color oddColor = { 40, 180, 120, 255 };
+		grid.setColors(baseColor, oddColor, 0);
+
+		int x = 0;
+		runBenchmark("GridHitTest_uniform" + suffix, [&]()
+		{
+			x = (x + 97) % board.w;
+			hitTest.cellAt(x, (x * 7) % board.h);
+		});
+
+		GridHitTest hashed;
+		hashed.setCells(cells);
+		runBenchmark("GridHitTest_spatialHash" + suffix, [&]()
+		{
+			x = (x + 97) % board.w;
+			hashed.cellAt(x, (x * 7) % board.h);
+		});
+
+		//No window, layout is taken from the offscreen target
+		layout.update(NULL, renderer);
+		grid.setLayout(&layout);
+		runBenchmark("GridRenderer_render" + suffix, [&]()
+		{
+			grid.render(renderer);
+		});
+		runBenchmark("GridRenderer_rebuildAndRender" + suffix, [&]()
+		{
+			grid.invalidate();
+			grid.render(renderer);
+		});
+		int oddCell = 0;
+		runBenchmark("GridRenderer_newRoundAndRender" + suffix, [&]()
+		{
+			oddCell = (oddCell + 1) % (size * size);
+			grid.setColors(baseColor, oddColor, oddCell);
+			grid.render(renderer);
+		});
+	}
+
+	//Random numbers, one op is one 1024-word block
+	{
+		const int RNG_BLOCK = 1024;
+		std::vector<Uint64> words(RNG_BLOCK);
+		std::vector<Uint32> cells(RNG_BLOCK);
+		GameRng rng(1);
+		runBenchmark("GameRng_next_1024", [&]()
+		{
+			for (int i = 0; i < RNG_BLOCK; i++)
+			{
+				words[i] = rng.next();
+			}
+		});
+		runBenchmark("GameRng_nextBelow_1024", [&]()
+		{
+			for (int i = 0; i < RNG_BLOCK; i++)
+			{
+				cells[i] = rng.nextBelow(9);
+			}
+		});
+		GameRngBatch batch(1);
+		runBenchmark("GameRngBatch_fill_1024", [&]()
+		{
+			batch.fill(&words[0], RNG_BLOCK);
+		});
+		runBenchmark("GameRngBatch_fillBelow_1024", [&]()
+		{
+			batch.fillBelow(&cells[0], RNG_BLOCK, 9);
+		});
+	}
+
+	//Perceptual difficulty, table building is a one-off startup cost
+	{
+		const int PAIR_BLOCK = 1024;
+		std::vector<float> first(PAIR_BLOCK * 3), second(PAIR_BLOCK * 3), deltaE(PAIR_BLOCK);
+		GameRng rng(1);
+		for (int i = 0; i < PAIR_BLOCK; i++)
+		{
+			Uint64 bits = rng.next();
+			SDL_Color a = { (Uint8)bits, (Uint8)(bits >> 8), (Uint8)(bits >> 16), 255 };
+			SDL_Color b = { (Uint8)(bits >> 24), (Uint8)(bits >> 32), (Uint8)(bits >> 40), 255 };
+			LabColor labA = srgbToLab(a);
+			LabColor labB = srgbToLab(b);
+			first[i] = labA.L; first[PAIR_BLOCK + i] = labA.a; first[PAIR_BLOCK * 2 + i] = labA.b;
+			second[i] = labB.L; second[PAIR_BLOCK + i] = labB.a; second[PAIR_BLOCK * 2 + i] = labB.b;
+		}
+		LabBatch firstBatch = { &first[0], &first[PAIR_BLOCK], &first[PAIR_BLOCK * 2] };
+		LabBatch secondBatch = { &second[0], &second[PAIR_BLOCK], &second[PAIR_BLOCK * 2] };
+		runBenchmark("DeltaE2000_batch_1024", [&]()
+		{
+			deltaE2000Batch(firstBatch, secondBatch, &deltaE[0], PAIR_BLOCK);
+		});
+		runBenchmark("DifficultyTable_build", [&]()
+		{
+			DifficultyTable table;
+			table.build(MAX_LEVEL + 1);
+		});
+	}
+
+	//Color vision simulation of a full screen image, done once per image at load time
+	{
+		SDL_Surface* screen = SDL_CreateRGBSurfaceWithFormat(0, BENCH_WIDTH, BENCH_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+		GameRng rng(1);
+		for (int y = 0; y < screen->h; y++)
+		{
+			Uint32* row = (Uint32*)((Uint8*)screen->pixels + y * screen->pitch);
+			for (int x = 0; x < screen->w; x++)
+			{
+				row[x] = (Uint32)rng.next() | 0xFF000000;
+			}
+		}
+		runBenchmark("ColorVision_simulateSurface_deutan", [&]()
+		{
+			SDL_FreeSurface(simulateDeficiencySurface(screen, VISION_DEUTAN));
+		});
+		runBenchmark("ColorVision_simulateSurface_tritan", [&]()
+		{
+			SDL_FreeSurface(simulateDeficiencySurface(screen, VISION_TRITAN));
+		});
+		SDL_FreeSurface(screen);
+	}
+
+	//Full simulated frame: a correct click, then the retained redraw
+	if (font != NULL)
+	{
+		BoardLayout layout;
+		layout.setHudHeight(30);
+		layout.update(NULL, renderer);
+		GridRenderer grid;
+		grid.setLayout(&layout);
+		RetainedScene scene;
+		HudLabel timeLabel("Time: ");
+		HudLabel scoreLabel("Score: ");
+		timeLabel.setAtlas(&atlas);
+		scoreLabel.setAtlas(&atlas);
+		SdlRenderer frameRenderer(renderer, &layout, &grid, &scene, &timeLabel, &scoreLabel);
+
+		//Frames are drawn from the board snapshot the game hands its render thread
+		GameSession session(0, 3, 3, 0, NULL);
+		ColorGameEngine& engine = session.getEngine();
+		BoardMessage board;
+		Uint64 micros = 0;
+		session.click(0, micros);
+		runBenchmark("Frame_clickAndRender", [&]()
+		{
+			micros += 16667;
+			if (engine.applyClick(engine.getOddCell(), micros) != CLICK_CORRECT)
+			{
+				engine.reset(micros);
+			}
+			session.writeBoard(&board);
+			frameRenderer.renderFrame(board);
+		});
+		runBenchmark("Frame_idle", [&]()
+		{
+			micros += 16667;
+			engine.step(micros);
+			session.writeBoard(&board);
+			frameRenderer.renderFrame(board);
+		});
+	}
+	else
+	{
+		skipBenchmark("Frame_clickAndRender", "font not found");
+		skipBenchmark("Frame_idle", "font not found");
+	}
+
+	writeJson(jsonPath);
+
+	atlas.free();
+	if (font != NULL)
+		TTF_CloseFont(font);
+	SDL_DestroyRenderer(renderer);
+	SDL_FreeSurface(target);
+	TTF_Quit();
+	IMG_Quit();
+	SDL_Quit();
+	return 0;
+}